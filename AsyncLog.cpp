@@ -0,0 +1,151 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "AsyncLog.h"
+#include "FrameTiming.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+#include <utility>
+
+static_assert((AsyncLog::Capacity & (AsyncLog::Capacity - 1)) == 0,
+              "AsyncLog::Capacity must be a power of two");
+
+AsyncLog::AsyncLog(DeliverFunction deliver, SyncFunction sync)
+    : enqueuePos_(0), dequeuePos_(0), dropped_(0),
+      deliver_(std::move(deliver)), sync_(std::move(sync)) {
+    for (std::size_t i = 0; i < Capacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+AsyncLog::~AsyncLog() {
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool AsyncLog::push(LogLevel level, const char *text) {
+    auto pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &cells_[pos & (Capacity - 1)];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+        if (diff == 0) {
+            // Free: claim it (on failure pos is reloaded for us).
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Still holds a record from one lap ago: full.
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            // Another producer claimed it first.
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    auto &record = cell->record;
+    record.level = level;
+    record.time = FrameTimingNow();
+    std::strncpy(record.text, text != nullptr ? text : "",
+                 LogRecord::MaxLength);
+    record.text[LogRecord::MaxLength] = '\0';
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLog::pop_(LogRecord &record) {
+    // Consumers are serialized by flushMutex_, so no CAS is needed here.
+    const auto pos = dequeuePos_.load(std::memory_order_relaxed);
+    auto &cell = cells_[pos & (Capacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+        // Empty, or the producer that claimed it is still writing.
+        return false;
+    }
+    record = cell.record;
+    dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+    cell.sequence.store(pos + Capacity, std::memory_order_release);
+    return true;
+}
+
+std::size_t AsyncLog::flush(bool sync) {
+    std::lock_guard<std::mutex> lock(flushMutex_);
+    LogRecord record;
+    std::size_t n = 0;
+    while (pop_(record)) {
+        // Outside the queue, so producers can reuse the cell meanwhile.
+        if (deliver_) {
+            deliver_(record);
+        }
+        ++n;
+    }
+    if (sync && sync_) {
+        sync_();
+    }
+    return n;
+}
+
+void AsyncLog::startDrainThread(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(threadMutex_);
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_ = false;
+    thread_ = std::thread([this, interval] {
+        std::unique_lock<std::mutex> lock(threadMutex_);
+        while (!stop_) {
+            cv_.wait_for(lock, interval);
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    });
+}
+
+void AsyncLog::stopDrainThread() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        stop_ = true;
+        thread = std::move(thread_);
+    }
+    cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+    flush(true);
+}
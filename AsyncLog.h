@@ -0,0 +1,132 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncLog_h_GUID_8F2D6A14_C73E_4B90_9E5A_1D47B0C38E26
+#define INCLUDED_AsyncLog_h_GUID_8F2D6A14_C73E_4B90_9E5A_1D47B0C38E26
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/// Severity of a log record.
+enum class LogLevel { Trace = 0, Debug = 1, Info = 2, Warning = 3, Error = 4 };
+
+/// Records below this level (a LogLevel value) are compiled out of the
+/// plugin: Info and up in release builds, everything but Trace otherwise.
+#ifndef OSVR_RP_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define OSVR_RP_MIN_LOG_LEVEL 2
+#else
+#define OSVR_RP_MIN_LOG_LEVEL 1
+#endif
+#endif
+
+/// One preformatted message, stored inline so queueing it never allocates.
+struct LogRecord {
+    static const std::size_t MaxLength = 247;
+    LogLevel level = LogLevel::Info;
+    /// FrameTimingNow() when it was logged.
+    std::int64_t time = 0;
+    /// NUL-terminated, truncated to MaxLength characters.
+    char text[MaxLength + 1];
+};
+
+/// Bounded multi-producer log queue. Any thread may push() without locking
+/// or allocating; when the queue is full the record is dropped and counted
+/// instead. Queued records are handed to the deliver function, in order, by
+/// flush() on the calling thread or by the optional drain thread. The sync
+/// function, if any, makes delivered records durable (say, flushes a file);
+/// it runs after flush(true), never concurrently with delivery.
+class AsyncLog {
+  public:
+    /// Queue capacity in records; a power of two.
+    static const std::size_t Capacity = 256;
+    using DeliverFunction = std::function<void(const LogRecord &)>;
+    using SyncFunction = std::function<void()>;
+
+    explicit AsyncLog(DeliverFunction deliver, SyncFunction sync = nullptr);
+
+    /// Stops the drain thread, if any, without delivering what is queued.
+    ~AsyncLog();
+
+    AsyncLog(AsyncLog const &) = delete;
+    AsyncLog &operator=(AsyncLog const &) = delete;
+
+    /// Any thread: queue a copy of @p text.
+    /// @return false if the queue was full and the record was dropped.
+    bool push(LogLevel level, const char *text);
+
+    /// Deliver everything queued so far on the calling thread, then, if
+    /// @p sync, call the sync function.
+    /// @return the number of records delivered.
+    std::size_t flush(bool sync = false);
+
+    /// Start a thread that flush()es every @p interval. No-op if running.
+    void startDrainThread(std::chrono::milliseconds interval);
+
+    /// Stop the drain thread, after one last flush(true).
+    void stopDrainThread();
+
+    /// Number of records dropped because the queue was full.
+    std::uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Cell {
+        /// Equal to the enqueue position when free, one past it when full.
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+    bool pop_(LogRecord &record);
+
+    std::array<Cell, Capacity> cells_;
+    std::atomic<std::size_t> enqueuePos_;
+    std::atomic<std::size_t> dequeuePos_;
+    std::atomic<std::uint64_t> dropped_;
+    DeliverFunction deliver_;
+    SyncFunction sync_;
+    /// Serializes consumers, so records are delivered in order.
+    std::mutex flushMutex_;
+
+    std::mutex threadMutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+#endif // INCLUDED_AsyncLog_h_GUID_8F2D6A14_C73E_4B90_9E5A_1D47B0C38E26
@@ -0,0 +1,92 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncPresenter.h"
+#include "RenderInfoSnapshot.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <utility>
+
+AsyncPresenter::AsyncPresenter(std::size_t framesInFlight,
+                               PresentFunction present)
+    : slots_(framesInFlight == 0 ? 1 : framesInFlight),
+      present_(std::move(present)) {
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        slots_[i].index = i;
+        // So copying a snapshot into a token never allocates.
+        slots_[i].renderInfo.reserve(RenderInfoSnapshot::MaxEyes);
+        slots_[i].renderBuffers.reserve(RenderInfoSnapshot::MaxEyes);
+        slots_[i].croppingViewports.reserve(RenderInfoSnapshot::MaxEyes);
+        slots_[i].eyeBuffers.reserve(RenderInfoSnapshot::MaxEyes);
+    }
+    thread_ = std::thread([&] { run_(); });
+}
+
+AsyncPresenter::~AsyncPresenter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+PresentToken &AsyncPresenter::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return queued_ < slots_.size(); });
+    return slots_[head_];
+}
+
+void AsyncPresenter::submit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        head_ = (head_ + 1) % slots_.size();
+        ++queued_;
+    }
+    cv_.notify_all();
+}
+
+void AsyncPresenter::run_() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [&] { return queued_ > 0 || stop_; });
+        if (queued_ == 0) {
+            // Stopping, and everything submitted has been presented.
+            return;
+        }
+        auto &token = slots_[tail_];
+        // The slot stays counted in queued_ while we present, so the render
+        // thread can't reuse it yet.
+        lock.unlock();
+        present_(token);
+        lock.lock();
+        tail_ = (tail_ + 1) % slots_.size();
+        --queued_;
+        cv_.notify_all();
+    }
+}
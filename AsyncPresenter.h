@@ -0,0 +1,106 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncPresenter_h_GUID_5B9E2C17_D04A_4E6F_8A31_F7C6D29B0E58
+#define INCLUDED_AsyncPresenter_h_GUID_5B9E2C17_D04A_4E6F_8A31_F7C6D29B0E58
+
+// Internal Includes
+#include "OsvrRenderingPlugin.h"
+
+// Library/third-party includes
+#include <osvr/RenderKit/RenderManager.h>
+
+// Standard includes
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Everything the present thread needs to present one frame the render
+/// thread has finished with.
+struct PresentToken {
+    /// Which of the presenter's slots this is; stable for its lifetime, so
+    /// per-slot resources (eye copies) can be indexed by it.
+    std::size_t index = 0;
+    std::vector<osvr::renderkit::RenderInfo> renderInfo;
+    /// The buffer presented for each eye.
+    std::vector<osvr::renderkit::RenderBuffer> renderBuffers;
+    /// With a swap chain, the swap chain buffer each eye presents, held until
+    /// the frame is done with it; otherwise empty.
+    std::vector<int> eyeBuffers;
+    /// The part of each eye's buffer that was rendered (empty: all of it).
+    std::vector<osvr::renderkit::OSVR_ViewportDescription> croppingViewports;
+    OSVR_FrameTiming timing = {};
+    bool lateLatch = false;
+    /// The display time renderInfo's poses were predicted for, in seconds on
+    /// the plugin's prediction clock, or 0 if they weren't predicted.
+    double predictionTarget = 0;
+    /// When the head pose was last late-latched for this frame, on the same
+    /// clock, or 0 if it hasn't been yet.
+    double latchTime = 0;
+};
+
+/// Owns a present thread and a fixed ring of PresentTokens. The render thread
+/// acquire()s a token, fills it and submit()s it; the present thread hands
+/// each submitted token to the present function in order. acquire() blocks
+/// once framesInFlight tokens are queued or being presented, which is the
+/// back-pressure that keeps the render thread from running ahead.
+class AsyncPresenter {
+  public:
+    using PresentFunction = std::function<void(PresentToken &)>;
+
+    /// Starts the present thread.
+    AsyncPresenter(std::size_t framesInFlight, PresentFunction present);
+
+    /// Presents everything already submitted, then stops the thread.
+    ~AsyncPresenter();
+
+    AsyncPresenter(AsyncPresenter const &) = delete;
+    AsyncPresenter &operator=(AsyncPresenter const &) = delete;
+
+    std::size_t framesInFlight() const { return slots_.size(); }
+
+    /// Render thread: wait for a free token. Must be followed by submit().
+    PresentToken &acquire();
+
+    /// Render thread: queue the token from acquire() for presentation.
+    void submit();
+
+  private:
+    void run_();
+
+    std::vector<PresentToken> slots_;
+    PresentFunction present_;
+    std::size_t head_ = 0;   //< next slot to acquire
+    std::size_t tail_ = 0;   //< next slot to present
+    std::size_t queued_ = 0; //< submitted, not yet fully presented
+    bool stop_ = false;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+#endif // INCLUDED_AsyncPresenter_h_GUID_5B9E2C17_D04A_4E6F_8A31_F7C6D29B0E58
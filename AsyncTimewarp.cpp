@@ -0,0 +1,126 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncTimewarp.h"
+#include "RenderInfoSnapshot.h"
+
+// Library/third-party includes
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Standard includes
+#include <utility>
+
+/// Best effort: ask the OS to schedule the timewarp thread ahead of the game's
+/// threads, so it makes every vsync even when they spike.
+static void raiseThreadPriority(std::thread &thread) {
+#ifdef _WIN32
+    SetThreadPriority(thread.native_handle(), THREAD_PRIORITY_TIME_CRITICAL);
+#else
+    // Usually needs privileges; without them we just keep normal priority.
+    sched_param param = {};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+#endif
+}
+
+AsyncTimewarp::AsyncTimewarp(PresentFunction present, RetireFunction retire)
+    : present_(std::move(present)), retire_(std::move(retire)) {
+    for (std::size_t i = 0; i < Slots; ++i) {
+        slots_[i].index = i;
+        // So filling a slot never allocates.
+        slots_[i].renderInfo.reserve(RenderInfoSnapshot::MaxEyes);
+        slots_[i].renderBuffers.reserve(RenderInfoSnapshot::MaxEyes);
+        slots_[i].croppingViewports.reserve(RenderInfoSnapshot::MaxEyes);
+        slots_[i].eyeBuffers.reserve(RenderInfoSnapshot::MaxEyes);
+    }
+    thread_ = std::thread([&] { run_(); });
+    raiseThreadPriority(thread_);
+}
+
+AsyncTimewarp::~AsyncTimewarp() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    for (auto slot : {current_, pending_}) {
+        if (slot != None) {
+            retire_(slots_[slot]);
+        }
+    }
+}
+
+PresentToken &AsyncTimewarp::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // With three slots, one is always neither current nor pending.
+    acquired_ = 0;
+    while (acquired_ == current_ || acquired_ == pending_) {
+        ++acquired_;
+    }
+    return slots_[acquired_];
+}
+
+PresentToken *AsyncTimewarp::submit() {
+    std::size_t replaced;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        replaced = pending_;
+        pending_ = acquired_;
+    }
+    cv_.notify_all();
+    return replaced == None ? nullptr : &slots_[replaced];
+}
+
+void AsyncTimewarp::run_() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Nothing to reproject until the first frame arrives.
+    cv_.wait(lock, [&] { return pending_ != None || stop_; });
+    while (!stop_) {
+        const bool fresh = pending_ != None;
+        std::size_t retired = None;
+        if (fresh) {
+            retired = current_;
+            current_ = pending_;
+            pending_ = None;
+            slots_[current_].lateLatch = true;
+        } else {
+            // Only the present-side stamps mean anything for a repeat.
+            slots_[current_].timing = OSVR_FrameTiming();
+        }
+        lock.unlock();
+        if (retired != None) {
+            retire_(slots_[retired]);
+        }
+        present_(slots_[current_], fresh);
+        lock.lock();
+    }
+}
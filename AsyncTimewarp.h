@@ -0,0 +1,98 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncTimewarp_h_GUID_2A7C4E91_B83D_4F06_9E5A_61D0C3B8F724
+#define INCLUDED_AsyncTimewarp_h_GUID_2A7C4E91_B83D_4F06_9E5A_61D0C3B8F724
+
+// Internal Includes
+#include "AsyncPresenter.h"
+
+// Library/third-party includes
+#include <osvr/RenderKit/RenderManager.h>
+
+// Standard includes
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/// Owns a high-priority thread that presents continuously: each call to the
+/// present function is expected to block until the next vsync. Every
+/// iteration presents the most recently submit()ted frame - a fresh frame if
+/// the render thread submitted one since the last present, otherwise the same
+/// one again, for timewarp to reproject with a newer head pose.
+///
+/// Frames live in Slots PresentTokens: the one being (re)presented, the one
+/// submitted but not yet picked up, and the one the render thread fills.
+/// Their index names per-slot eye buffers, so the render thread never writes
+/// buffers the timewarp thread may still present.
+class AsyncTimewarp {
+  public:
+    static const std::size_t Slots = 3;
+
+    /// Called on the timewarp thread with the frame to present and whether
+    /// it is new since the previous call.
+    using PresentFunction = std::function<void(PresentToken &, bool fresh)>;
+    /// Called with a presented frame once a fresher one replaces it (on the
+    /// timewarp thread), and with the frames left at destruction.
+    using RetireFunction = std::function<void(PresentToken &)>;
+
+    /// Starts the timewarp thread, which idles until the first submit().
+    AsyncTimewarp(PresentFunction present, RetireFunction retire);
+
+    /// Stops the thread, after at most one more present, and retires the
+    /// frames it still held.
+    ~AsyncTimewarp();
+
+    AsyncTimewarp(AsyncTimewarp const &) = delete;
+    AsyncTimewarp &operator=(AsyncTimewarp const &) = delete;
+
+    /// Render thread: a slot the timewarp thread isn't using, to fill and
+    /// submit(). Never blocks.
+    PresentToken &acquire();
+
+    /// Render thread: the slot from acquire() holds a completed frame. Its
+    /// lateLatch flag is ignored (timewarp always late-latches).
+    /// @return the submitted frame this one replaced before it was ever
+    /// presented, or nullptr.
+    PresentToken *submit();
+
+  private:
+    static const std::size_t None = Slots;
+    void run_();
+
+    PresentFunction present_;
+    RetireFunction retire_;
+    PresentToken slots_[Slots];
+    std::size_t acquired_ = 0;   //< the render thread's
+    std::size_t pending_ = None; //< latest submitted, not yet presented
+    std::size_t current_ = None; //< the one the thread is (re)presenting
+    bool stop_ = false;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+#endif // INCLUDED_AsyncTimewarp_h_GUID_2A7C4E91_B83D_4F06_9E5A_61D0C3B8F724
@@ -0,0 +1,261 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "CombinedFrustum.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+
+namespace {
+struct Vec3 {
+    double x, y, z;
+};
+inline Vec3 operator+(Vec3 a, Vec3 b) {
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+inline Vec3 operator-(Vec3 a, Vec3 b) {
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+inline Vec3 operator*(double s, Vec3 v) { return {s * v.x, s * v.y, s * v.z}; }
+inline Vec3 cross(Vec3 a, Vec3 b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+            a.x * b.y - a.y * b.x};
+}
+
+struct Quat {
+    double w, x, y, z;
+};
+
+inline Vec3 translationOf(const OSVR_PoseState &pose) {
+    return {osvrVec3GetX(&pose.translation), osvrVec3GetY(&pose.translation),
+            osvrVec3GetZ(&pose.translation)};
+}
+inline Quat rotationOf(const OSVR_PoseState &pose) {
+    return {osvrQuatGetW(&pose.rotation), osvrQuatGetX(&pose.rotation),
+            osvrQuatGetY(&pose.rotation), osvrQuatGetZ(&pose.rotation)};
+}
+
+/// q * v * conj(q), for unit q.
+inline Vec3 rotate(const Quat &q, Vec3 v) {
+    const Vec3 u = {q.x, q.y, q.z};
+    const Vec3 t = 2 * cross(u, v);
+    return v + q.w * t + cross(u, t);
+}
+inline Vec3 rotateInverse(const Quat &q, Vec3 v) {
+    return rotate(Quat{q.w, -q.x, -q.y, -q.z}, v);
+}
+
+/// Samples per side of each slice, and slices, when measuring eye volume.
+const int VolumeGridSize = 32;
+/// Eyes beyond this many are left out of the eye volume.
+const std::size_t MaxMeasuredEyes = 16;
+
+/// An eye's frustum as seen from the combined camera's frame: p_eye =
+/// m * p + offset. Bounds are slopes at unit depth.
+struct EyeInCombinedFrame {
+    Vec3 m[3]; // columns
+    Vec3 offset;
+    double left, right, bottom, top, nearClip, farClip;
+
+    bool contains(Vec3 p) const {
+        const Vec3 e = p.x * m[0] + p.y * m[1] + p.z * m[2] + offset;
+        const double depth = -e.z;
+        return depth >= nearClip && depth <= farClip &&
+               e.x >= left * depth && e.x <= right * depth &&
+               e.y >= bottom * depth && e.y <= top * depth;
+    }
+};
+} // namespace
+
+bool ComputeCombinedFrustum(
+    const OSVR_PoseState *poses,
+    const osvr::renderkit::OSVR_ProjectionMatrix *projections,
+    std::size_t eyeCount, bool measureEyeVolume, CombinedFrustum &out) {
+    if (eyeCount == 0) {
+        return false;
+    }
+    for (std::size_t i = 0; i < eyeCount; ++i) {
+        const auto &p = projections[i];
+        if (!(p.nearClip > 0 && p.farClip > p.nearClip && p.right > p.left &&
+              p.top > p.bottom)) {
+            return false;
+        }
+    }
+
+    // Average orientation (on the first eye's side of the double cover) and
+    // position.
+    const Quat q0 = rotationOf(poses[0]);
+    Quat qc = {0, 0, 0, 0};
+    Vec3 center = {0, 0, 0};
+    for (std::size_t i = 0; i < eyeCount; ++i) {
+        const Quat q = rotationOf(poses[i]);
+        const double sign =
+            q.w * q0.w + q.x * q0.x + q.y * q0.y + q.z * q0.z < 0 ? -1 : 1;
+        qc.w += sign * q.w;
+        qc.x += sign * q.x;
+        qc.y += sign * q.y;
+        qc.z += sign * q.z;
+        center = center + (1. / eyeCount) * translationOf(poses[i]);
+    }
+    const double norm =
+        1 / std::sqrt(qc.w * qc.w + qc.x * qc.x + qc.y * qc.y + qc.z * qc.z);
+    qc = {qc.w * norm, qc.x * norm, qc.y * norm, qc.z * norm};
+
+    // Place the apex as if the eyes were parallel: back far enough that
+    // lines at the widest eye slopes through the outermost eyes meet.
+    const double inf = std::numeric_limits<double>::infinity();
+    double left = inf, right = -inf, bottom = inf, top = -inf;
+    double minX = inf, maxX = -inf, minY = inf, maxY = -inf, maxZ = -inf;
+    for (std::size_t i = 0; i < eyeCount; ++i) {
+        const auto &p = projections[i];
+        left = std::min(left, p.left / p.nearClip);
+        right = std::max(right, p.right / p.nearClip);
+        bottom = std::min(bottom, p.bottom / p.nearClip);
+        top = std::max(top, p.top / p.nearClip);
+        const Vec3 e = rotateInverse(qc, translationOf(poses[i]) - center);
+        minX = std::min(minX, e.x);
+        maxX = std::max(maxX, e.x);
+        minY = std::min(minY, e.y);
+        maxY = std::max(maxY, e.y);
+        maxZ = std::max(maxZ, e.z);
+    }
+    const double back = std::max((maxX - minX) / (right - left),
+                                 (maxY - minY) / (top - bottom));
+    const Vec3 apex = {(minX - left * back + maxX - right * back) / 2,
+                       (minY - bottom * back + maxY - top * back) / 2,
+                       maxZ + back};
+
+    // Then bound every eye frustum's corners as seen from there: the
+    // combined frustum is convex, so holding the corners means holding the
+    // eye frusta.
+    left = bottom = inf;
+    right = top = -inf;
+    double nearClip = inf, farClip = -inf;
+    for (std::size_t i = 0; i < eyeCount; ++i) {
+        const auto &p = projections[i];
+        const Quat q = rotationOf(poses[i]);
+        const Vec3 t = translationOf(poses[i]);
+        for (double depth : {p.nearClip, p.farClip}) {
+            const double scale = depth / p.nearClip;
+            for (double x : {p.left, p.right}) {
+                for (double y : {p.bottom, p.top}) {
+                    const Vec3 corner = {x * scale, y * scale, -depth};
+                    const Vec3 c =
+                        rotateInverse(qc, t + rotate(q, corner) - center) -
+                        apex;
+                    const double d = -c.z;
+                    if (!(d > 0)) {
+                        return false;
+                    }
+                    left = std::min(left, c.x / d);
+                    right = std::max(right, c.x / d);
+                    bottom = std::min(bottom, c.y / d);
+                    top = std::max(top, c.y / d);
+                    nearClip = std::min(nearClip, d);
+                    farClip = std::max(farClip, d);
+                }
+            }
+        }
+    }
+
+    const Vec3 position = center + rotate(qc, apex);
+    osvrVec3SetX(&out.pose.translation, position.x);
+    osvrVec3SetY(&out.pose.translation, position.y);
+    osvrVec3SetZ(&out.pose.translation, position.z);
+    osvrQuatSetW(&out.pose.rotation, qc.w);
+    osvrQuatSetX(&out.pose.rotation, qc.x);
+    osvrQuatSetY(&out.pose.rotation, qc.y);
+    osvrQuatSetZ(&out.pose.rotation, qc.z);
+    out.projection.left = left * nearClip;
+    out.projection.right = right * nearClip;
+    out.projection.bottom = bottom * nearClip;
+    out.projection.top = top * nearClip;
+    out.projection.nearClip = nearClip;
+    out.projection.farClip = farClip;
+    const double area = (right - left) * (top - bottom);
+    const auto cube = [](double z) { return z * z * z; };
+    out.volume = area * (cube(farClip) - cube(nearClip)) / 3;
+    out.eyeVolume = -1;
+    if (!measureEyeVolume) {
+        return true;
+    }
+
+    // Fraction of a grid in each depth slice inside some eye, weighted by
+    // the slice's volume. Slices are spaced geometrically, so the apex,
+    // where the combined frustum has most to spare, gets as many as the
+    // far distance.
+    EyeInCombinedFrame eyes[MaxMeasuredEyes];
+    const std::size_t testedEyes = std::min(eyeCount, MaxMeasuredEyes);
+    for (std::size_t i = 0; i < testedEyes; ++i) {
+        const auto &p = projections[i];
+        const Quat q = rotationOf(poses[i]);
+        auto &eye = eyes[i];
+        const Vec3 axes[3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+        for (int j = 0; j < 3; ++j) {
+            eye.m[j] = rotateInverse(q, rotate(qc, axes[j]));
+        }
+        eye.offset = rotateInverse(q, position - translationOf(poses[i]));
+        eye.left = p.left / p.nearClip;
+        eye.right = p.right / p.nearClip;
+        eye.bottom = p.bottom / p.nearClip;
+        eye.top = p.top / p.nearClip;
+        eye.nearClip = p.nearClip;
+        eye.farClip = p.farClip;
+    }
+    const double ratio = std::pow(farClip / nearClip, 1. / VolumeGridSize);
+    double eyeVolume = 0;
+    double z0 = nearClip;
+    for (int k = 0; k < VolumeGridSize; ++k) {
+        const double z1 = k + 1 == VolumeGridSize ? farClip : z0 * ratio;
+        const double z = (z0 + z1) / 2;
+        int inside = 0;
+        for (int i = 0; i < VolumeGridSize; ++i) {
+            const double x =
+                z * (left + (right - left) * (i + 0.5) / VolumeGridSize);
+            for (int j = 0; j < VolumeGridSize; ++j) {
+                const double y =
+                    z * (bottom + (top - bottom) * (j + 0.5) / VolumeGridSize);
+                const Vec3 sample = {x, y, -z};
+                for (std::size_t e = 0; e < testedEyes; ++e) {
+                    if (eyes[e].contains(sample)) {
+                        ++inside;
+                        break;
+                    }
+                }
+            }
+        }
+        eyeVolume += area * (cube(z1) - cube(z0)) / 3 * inside /
+                     (VolumeGridSize * VolumeGridSize);
+        z0 = z1;
+    }
+    out.eyeVolume = eyeVolume;
+    return true;
+}
@@ -0,0 +1,70 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_CombinedFrustum_h_GUID_0D6B3F94_A27C_4E18_B5D3_9C41E8F72A05
+#define INCLUDED_CombinedFrustum_h_GUID_0D6B3F94_A27C_4E18_B5D3_9C41E8F72A05
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/RenderKit/RenderKitGraphicsTransforms.h>
+#include <osvr/Util/Pose3C.h>
+
+// Standard includes
+#include <cstddef>
+
+/// A single camera whose frustum encloses every eye's, for culling once
+/// for all eyes.
+struct CombinedFrustum {
+    /// Of the combined camera in room space, like an eye pose: OpenGL
+    /// convention, looking down -Z.
+    OSVR_PoseState pose;
+    osvr::renderkit::OSVR_ProjectionMatrix projection;
+    /// Volume of the combined frustum, in cubic meters.
+    double volume = 0;
+    /// Volume covered by at least one eye's frustum; negative if not
+    /// measured.
+    double eyeVolume = -1;
+};
+
+/// Compute the combined frustum of @p eyeCount eyes.
+///
+/// The combined camera takes the eyes' average orientation and sits behind
+/// their average position, far enough back that its frustum can take in
+/// the outer edges of every eye's (the usual stereo culling camera). Its
+/// bounds then come from the corners of every eye frustum, so it encloses
+/// all of them even when the eyes are canted or asymmetric.
+///
+/// Measuring @c eyeVolume samples the combined frustum on a grid, a few
+/// hundred microseconds' work, so it is optional.
+///
+/// @return false if there are no eyes or their frusta don't all lie in
+/// front of a common camera.
+bool ComputeCombinedFrustum(
+    const OSVR_PoseState *poses,
+    const osvr::renderkit::OSVR_ProjectionMatrix *projections,
+    std::size_t eyeCount, bool measureEyeVolume, CombinedFrustum &out);
+
+#endif // INCLUDED_CombinedFrustum_h_GUID_0D6B3F94_A27C_4E18_B5D3_9C41E8F72A05
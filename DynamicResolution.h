@@ -0,0 +1,83 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DynamicResolution_h_GUID_E41B7C2D_9A05_4F38_B6E1_3C8D57A2F190
+#define INCLUDED_DynamicResolution_h_GUID_E41B7C2D_9A05_4F38_B6E1_3C8D57A2F190
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+/// Tuning for DynamicResolutionController.
+struct DynamicResolutionConfig {
+    /// The frame interval to hold, e.g. the display's refresh interval.
+    double targetFrameSeconds = 1.0 / 90.0;
+    /// A frame longer than targetFrameSeconds * missTolerance counts as a
+    /// missed frame.
+    double missTolerance = 1.25;
+    /// Scale limits; 1 is the full, preallocated, eye buffer size.
+    double minScale = 0.5;
+    double maxScale = 1.0;
+    /// How far one missed frame shrinks the scale.
+    double decreaseStep = 0.05;
+    /// How far a run of growAfterFrames on-time frames grows the scale.
+    double increaseStep = 0.02;
+    unsigned growAfterFrames = 45;
+};
+
+/// Picks the fraction of each eye buffer's width and height to render,
+/// from measured frame intervals: shrinks quickly after a missed frame,
+/// grows slowly back while frames stay on time.
+class DynamicResolutionController {
+  public:
+    explicit DynamicResolutionController(
+        DynamicResolutionConfig const &config = DynamicResolutionConfig())
+        : config_(config), scale_(config.maxScale) {}
+
+    /// Feed one frame interval; returns the scale for the next frame.
+    double update(double frameSeconds) {
+        if (frameSeconds > config_.targetFrameSeconds * config_.missTolerance) {
+            scale_ = std::max(config_.minScale, scale_ - config_.decreaseStep);
+            onTimeFrames_ = 0;
+        } else if (++onTimeFrames_ >= config_.growAfterFrames) {
+            scale_ = std::min(config_.maxScale, scale_ + config_.increaseStep);
+            onTimeFrames_ = 0;
+        }
+        return scale_;
+    }
+
+    double scale() const { return scale_; }
+
+  private:
+    DynamicResolutionConfig config_;
+    double scale_;
+    unsigned onTimeFrames_ = 0;
+};
+
+#endif // INCLUDED_DynamicResolution_h_GUID_E41B7C2D_9A05_4F38_B6E1_3C8D57A2F190
@@ -0,0 +1,106 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FrameTiming_h_GUID_3D0E8B71_52A6_4C1F_8E93_A4F26B1D07C5
+#define INCLUDED_FrameTiming_h_GUID_3D0E8B71_52A6_4C1F_8E93_A4F26B1D07C5
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/// Monotonic timestamp in nanoseconds, the time base for all frame timings.
+inline std::int64_t FrameTimingNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Fixed-size ring of records with one producer and one consumer. The
+/// producer never waits: when the consumer falls behind, the oldest records
+/// are overwritten and counted as dropped.
+template <typename T, std::size_t N> class TimingRingBuffer {
+  public:
+    /// Producer side: append a record, overwriting the oldest if full.
+    void push(const T &record) {
+        const auto head = head_.load(std::memory_order_relaxed);
+        slots_[head % N] = record;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /// Consumer side: copy up to @p count of the oldest unread records into
+    /// @p out.
+    /// @return the number of records copied.
+    std::size_t pop(T *out, std::size_t count) {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        const auto head = head_.load(std::memory_order_acquire);
+        if (head - tail > N) {
+            dropped_.fetch_add(head - N - tail, std::memory_order_relaxed);
+            tail = head - N;
+        }
+        std::size_t n = 0;
+        for (; n < count && tail + n < head; ++n) {
+            out[n] = slots_[(tail + n) % N];
+        }
+        // The producer may have lapped us while we copied: anything at or
+        // before (current head - N) could have been overwritten mid-copy.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto headAfter = head_.load(std::memory_order_relaxed);
+        std::size_t skip = 0;
+        if (headAfter >= N && headAfter - N + 1 > tail) {
+            skip = static_cast<std::size_t>(
+                std::min<std::uint64_t>(headAfter - N + 1 - tail, n));
+        }
+        if (skip > 0) {
+            for (std::size_t i = skip; i < n; ++i) {
+                out[i - skip] = out[i];
+            }
+            dropped_.fetch_add(skip, std::memory_order_relaxed);
+        }
+        tail_.store(tail + n, std::memory_order_relaxed);
+        return n - skip;
+    }
+
+    /// Records overwritten before the consumer could read them.
+    std::uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<std::uint64_t> head_{0};
+    std::atomic<std::uint64_t> tail_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::array<T, N> slots_;
+};
+
+#endif // INCLUDED_FrameTiming_h_GUID_3D0E8B71_52A6_4C1F_8E93_A4F26B1D07C5
@@ -0,0 +1,221 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HiddenAreaMesh.h"
+
+// Library/third-party includes
+#include <json/reader.h>
+#include <json/value.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const double Pi = 3.14159265358979323846;
+
+/// Distance from @p origin along (dx, dy) to the edge of [0, w] x [0, h],
+/// for an origin inside it.
+inline double distanceToEdge(const double origin[2], double dx, double dy,
+                             double w, double h) {
+    double t = HUGE_VAL;
+    if (dx > 0) {
+        t = std::min(t, (w - origin[0]) / dx);
+    } else if (dx < 0) {
+        t = std::min(t, -origin[0] / dx);
+    }
+    if (dy > 0) {
+        t = std::min(t, (h - origin[1]) / dy);
+    } else if (dy < 0) {
+        t = std::min(t, -origin[1] / dy);
+    }
+    return t;
+}
+
+inline double evaluate(const std::vector<double> &polynomial, double r) {
+    double result = 0;
+    for (auto it = polynomial.rbegin(); it != polynomial.rend(); ++it) {
+        result = result * r + *it;
+    }
+    return result;
+}
+
+inline void addTriangle(std::vector<float> &out, const double a[2],
+                        const double b[2], const double c[2]) {
+    for (const double *v : {a, b, c}) {
+        out.push_back(static_cast<float>(v[0]));
+        out.push_back(static_cast<float>(v[1]));
+    }
+}
+} // namespace
+
+bool ParseLensDistortion(const std::string &displayDescriptor,
+                         std::vector<LensDistortion> &eyes,
+                         std::string &error) {
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(displayDescriptor, root, false)) {
+        error = reader.getFormattedErrorMessages();
+        return false;
+    }
+    const Json::Value &hmd = root["hmd"];
+    const Json::Value &eyeList = hmd["eyes"];
+    if (!eyeList.isArray() || eyeList.size() == 0) {
+        error = "no eyes in the display descriptor";
+        return false;
+    }
+
+    LensDistortion common = {};
+    common.distanceScale[0] = common.distanceScale[1] = 1;
+    common.lensOutline = hmd.isMember("field_of_view");
+    const Json::Value &distortion = hmd["distortion"];
+    if (distortion.isObject() && distortion.isMember("type") &&
+        distortion["type"].asString() != "rgb_symmetric_polynomials") {
+        error = "unsupported distortion type " +
+                distortion["type"].asString();
+        return false;
+    }
+    if (distortion.isMember("distance_scale_x")) {
+        common.distanceScale[0] = distortion["distance_scale_x"].asDouble();
+    }
+    if (distortion.isMember("distance_scale_y")) {
+        common.distanceScale[1] = distortion["distance_scale_y"].asDouble();
+    }
+    const char *const polynomialNames[3] = {"polynomial_coeffs_red",
+                                            "polynomial_coeffs_green",
+                                            "polynomial_coeffs_blue"};
+    for (int color = 0; color < 3; ++color) {
+        const Json::Value &coefficients = distortion[polynomialNames[color]];
+        for (Json::ArrayIndex i = 0;
+             coefficients.isArray() && i < coefficients.size(); ++i) {
+            common.polynomials[color].push_back(coefficients[i].asDouble());
+        }
+        if (common.polynomials[color].empty()) {
+            // No distortion: r -> r.
+            common.polynomials[color] = {0., 1.};
+        }
+    }
+    if (!(common.distanceScale[0] > 0 && common.distanceScale[1] > 0)) {
+        error = "distortion distance scale must be positive";
+        return false;
+    }
+
+    eyes.assign(eyeList.size(), common);
+    for (Json::ArrayIndex i = 0; i < eyeList.size(); ++i) {
+        const Json::Value &eye = eyeList[i];
+        auto &cop = eyes[i].centerOfProjection;
+        cop[0] = eye.isMember("center_proj_x")
+                     ? eye["center_proj_x"].asDouble()
+                     : 0.5;
+        cop[1] = eye.isMember("center_proj_y")
+                     ? eye["center_proj_y"].asDouble()
+                     : 0.5;
+        if (!(cop[0] > 0 && cop[0] < 1 && cop[1] > 0 && cop[1] < 1)) {
+            error = "center of projection outside the eye";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool operator==(const LensDistortion &a, const LensDistortion &b) {
+    return a.centerOfProjection[0] == b.centerOfProjection[0] &&
+           a.centerOfProjection[1] == b.centerOfProjection[1] &&
+           a.distanceScale[0] == b.distanceScale[0] &&
+           a.distanceScale[1] == b.distanceScale[1] &&
+           a.polynomials[0] == b.polynomials[0] &&
+           a.polynomials[1] == b.polynomials[1] &&
+           a.polynomials[2] == b.polynomials[2] &&
+           a.lensOutline == b.lensOutline;
+}
+
+HiddenAreaMesh BuildHiddenAreaMesh(const LensDistortion &distortion,
+                                   std::size_t segments) {
+    // Work in distance-scaled coordinates, where the distortion is radial.
+    const double w = distortion.distanceScale[0];
+    const double h = distortion.distanceScale[1];
+    const double cop[2] = {distortion.centerOfProjection[0] * w,
+                           distortion.centerOfProjection[1] * h};
+
+    // Evenly spaced rays, plus one through each corner of the buffer so the
+    // hidden mesh reaches into them.
+    std::vector<double> angles;
+    for (std::size_t i = 0; i < segments; ++i) {
+        angles.push_back(2 * Pi * i / segments);
+    }
+    const double corners[4][2] = {{w, h}, {0, h}, {0, 0}, {w, 0}};
+    for (const auto &corner : corners) {
+        double angle = std::atan2(corner[1] - cop[1], corner[0] - cop[0]);
+        angles.push_back(angle < 0 ? angle + 2 * Pi : angle);
+    }
+    std::sort(angles.begin(), angles.end());
+
+    // The lens outline's radii, pushed out so the chords between rays stay
+    // outside it rather than hiding a sliver of what the lens shows.
+    const double push = 1 / std::cos(Pi / segments);
+    const double lens[2] = {std::max(cop[0], w - cop[0]) * push,
+                            std::max(cop[1], h - cop[1]) * push};
+
+    // Where each ray leaves the visible area and the buffer, in normalized
+    // buffer coordinates.
+    const std::size_t n = angles.size();
+    std::vector<double> inner(2 * n), outer(2 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double dx = std::cos(angles[i]);
+        const double dy = std::sin(angles[i]);
+        // The display shares the buffer's normalized extent.
+        const double edge = distanceToEdge(cop, dx, dy, w, h);
+        double visible = 0;
+        for (const auto &polynomial : distortion.polynomials) {
+            visible = std::max(visible, evaluate(polynomial, edge));
+        }
+        if (distortion.lensOutline) {
+            visible = std::min(visible,
+                               1 / std::hypot(dx / lens[0], dy / lens[1]));
+        }
+        visible = std::min(visible, edge);
+        inner[2 * i] = (cop[0] + dx * visible) / w;
+        inner[2 * i + 1] = (cop[1] + dy * visible) / h;
+        outer[2 * i] = (cop[0] + dx * edge) / w;
+        outer[2 * i + 1] = (cop[1] + dy * edge) / h;
+    }
+
+    HiddenAreaMesh mesh;
+    const double center[2] = {distortion.centerOfProjection[0],
+                              distortion.centerOfProjection[1]};
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = (i + 1) % n;
+        const double *a = &inner[2 * i];
+        const double *b = &inner[2 * j];
+        const double *c = &outer[2 * i];
+        const double *d = &outer[2 * j];
+        if (a[0] != c[0] || a[1] != c[1] || b[0] != d[0] || b[1] != d[1]) {
+            addTriangle(mesh.hidden, a, c, d);
+            addTriangle(mesh.hidden, a, d, b);
+        }
+        addTriangle(mesh.visible, center, a, b);
+    }
+    return mesh;
+}
@@ -0,0 +1,92 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HiddenAreaMesh_h_GUID_9F2C6B40_E81D_4A37_B0C5_63D8A1E47F92
+#define INCLUDED_HiddenAreaMesh_h_GUID_9F2C6B40_E81D_4A37_B0C5_63D8A1E47F92
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// One eye's lens distortion, as the display descriptor gives it to
+/// RenderManager: symmetric polynomials per color about a center of
+/// projection, in texture coordinates scaled by distanceScale.
+struct LensDistortion {
+    double centerOfProjection[2];
+    double distanceScale[2];
+    /// Red, green, blue: distorted radius = sum of coefficient i * r^i.
+    std::vector<double> polynomials[3];
+    /// Whether the descriptor gives the field of view seen through a lens,
+    /// whose round outline then hides the buffer's corners.
+    bool lensOutline;
+};
+
+bool operator==(const LensDistortion &a, const LensDistortion &b);
+inline bool operator!=(const LensDistortion &a, const LensDistortion &b) {
+    return !(a == b);
+}
+
+/// Read each eye's LensDistortion from a display descriptor (the JSON at
+/// the /display path). Only "rgb_symmetric_polynomials" distortion is
+/// understood; a descriptor with no distortion gives the identity. A
+/// "field_of_view" in the descriptor sets lensOutline.
+/// @return false, with a reason in @p error, if it can't be used.
+bool ParseLensDistortion(const std::string &displayDescriptor,
+                         std::vector<LensDistortion> &eyes,
+                         std::string &error);
+
+/// Triangle lists (three x, y pairs per triangle) in an eye buffer's
+/// normalized coordinates: 0 to 1, y up, as GL.LoadOrtho sets up.
+struct HiddenAreaMesh {
+    /// The parts of the buffer no display pixel samples, in any color.
+    std::vector<float> hidden;
+    /// The rest: a fan about the center of projection.
+    std::vector<float> visible;
+};
+
+/// Build the meshes for one eye. The distortion maps each ray from the
+/// center of projection onto itself, so along @p segments rays (plus the
+/// buffer's corners) the last sampled point is just the polynomial of where
+/// the ray leaves the display.
+///
+/// With lensOutline, what lies outside the lens is hidden too. The lens is
+/// taken to be round about the center of projection, showing the field of
+/// view out to the buffer's farthest edge along each axis: an ellipse in
+/// the buffer's 0 to 1 coordinates, which is a circle in the tangent space
+/// the buffer is rendered in. On the HDK, that hides the buffer's corners.
+///
+/// Render overfill is not accounted for, so its margin stays in the visible
+/// mesh for timewarp to sample; without overfill, timewarp can reach a
+/// little into the hidden area while the head turns.
+HiddenAreaMesh BuildHiddenAreaMesh(const LensDistortion &distortion,
+                                   std::size_t segments = 64);
+
+#endif // INCLUDED_HiddenAreaMesh_h_GUID_9F2C6B40_E81D_4A37_B0C5_63D8A1E47F92
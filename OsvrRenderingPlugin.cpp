@@ -26,6 +26,20 @@ Sensics, Inc.
 
 // Internal includes
 #include "OsvrRenderingPlugin.h"
+#include "AsyncLog.h"
+#include "AsyncPresenter.h"
+#include "AsyncTimewarp.h"
+#include "CombinedFrustum.h"
+#include "DynamicResolution.h"
+#include "PosePredictor.h"
+#include "PoseTraceRecorder.h"
+#include "FrameTiming.h"
+#include "HiddenAreaMesh.h"
+#include "RenderBackend.h"
+#include "RenderInfoSnapshot.h"
+#include "StandInRenderBackend.h"
+#include "TraceReplayBackend.h"
+#include "UnityMatrices.h"
 #include "Unity/IUnityGraphics.h"
 #include "UnityRendererType.h"
 
@@ -33,14 +47,28 @@ Sensics, Inc.
 #include "osvr/RenderKit/RenderManager.h"
 #include <osvr/ClientKit/Context.h>
 #include <osvr/ClientKit/Interface.h>
+#include <osvr/ClientKit/InterfaceStateC.h>
+#include <osvr/ClientKit/ParametersC.h>
 #include <osvr/Util/Finally.h>
 #include <osvr/Util/MatrixConventionsC.h>
+#include <osvr/Util/TimeValueC.h>
 // standard includes
 #if defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
 #include <fstream>
 #include <iostream>
 #endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #if UNITY_WIN
 #define NO_MINMAX
@@ -78,14 +106,185 @@ static IUnityGraphics *s_Graphics = nullptr;
 static UnityRendererType s_deviceType = {};
 
 static osvr::renderkit::RenderManager::RenderParams s_renderParams;
-static osvr::renderkit::RenderManager *s_render = nullptr;
+static RenderBackend *s_render = nullptr;
 static OSVR_ClientContext s_clientContext = nullptr;
+/// "/me/head", acquired on first use by the late-latching render event.
+static OSVR_ClientInterface s_headInterface = nullptr;
+/// Freshest head pose (predicted to the frame's display time if its poses
+/// were), handed to RenderManager's timewarp when late-latching.
+static OSVR_PoseState s_lateLatchedHeadPose;
+
+// Pose prediction. Everything but the lead time, measured latency and
+// predicted poses is guarded by s_renderInfoWriterMutex (it goes with the
+// client context). Device 0 is always the head.
+static PosePredictor s_posePredictor;
+static OSVR_ClientInterface
+    s_predictedInterfaces[PosePredictor::MaxDevices] = {};
+static std::size_t s_predictedDeviceCount = 1;
+static OSVR_TimeValue s_predictionEpoch = {};
+/// 0: no prediction; > 0: predict this far ahead; < 0: predict by
+/// s_measuredDisplayLatency.
+static std::atomic<double> s_predictionLeadTime{0};
+/// Moving average of pose fetch to present return, seconds.
+static std::atomic<double> s_measuredDisplayLatency{0};
+static std::mutex s_predictedPosesMutex;
+static OSVR_PoseState s_predictedPoses[PosePredictor::MaxDevices];
+/// The display time, in seconds since s_predictionEpoch, that the published
+/// render info was predicted for; 0 if it wasn't predicted.
+static std::atomic<double> s_lastPredictionTarget{0};
+/// Every buffer registered with RenderManager: one per eye, or with a swap
+/// chain, s_swapChainLength per eye (eye-major).
 static std::vector<osvr::renderkit::RenderBuffer> s_renderBuffers;
+/// How to release each of s_renderBuffers; set when they're built.
+static void (*s_renderBufferCleanup)(osvr::renderkit::RenderBuffer &) =
+    nullptr;
+/// The per-API operations for s_deviceType, selected by SelectGraphicsBackend
+/// on graphics device initialize and whenever RenderManager is created or
+/// shut down; null while there is no supported device, so callers check
+/// s_deviceType first.
+struct GraphicsBackend {
+    void (*deviceEvent)(UnityGfxDeviceEventType eventType);
+    /// Buffers wrapping the textures set from Unity, one per eye.
+    OSVR_ReturnCode (*constructBuffers)(int eyes);
+    /// Plugin-owned swap chain buffers, eye-major.
+    OSVR_ReturnCode (*constructSwapChain)(int buffers);
+    OSVR_ReturnCode (*constructFoveatedBuffers)(int eyes);
+    /// The native texture behind one of s_renderBuffers.
+    void *(*nativeTexture)(const osvr::renderkit::RenderBuffer &rb);
+    /// Note the texture Unity set for @p eye.
+    void (*recordEyeTexture)(int eye, void *texturePtr);
+    /// Handle a render event.
+    void (*render)(bool lateLatch);
+};
+static std::atomic<const GraphicsBackend *> s_backend{nullptr};
+/// Opt-in recording of what the plugin saw and did, for StartPoseTrace.
+static PoseTraceRecorder s_poseTrace;
+/// Set by a device BeforeReset that released buffers, for AfterReset to
+/// rebuild them.
+static bool s_rebuildBuffersAfterReset = false;
+/// Taken around the body of ShutdownRenderManager, which the render thread
+/// may run for another thread (see s_shutdownPending), and around
+/// FinishCreateRenderManagerAsync. Also guards s_createThread and
+/// s_createdRenderManager: whoever takes the thread out is the one to join it.
+static std::mutex s_renderManagerMutex;
+/// Set when ShutdownRenderManager couldn't get the present thread stopped:
+/// the render thread then finishes the shutdown at its next render event.
+static std::atomic<bool> s_shutdownPending{false};
+
+/// What creating a RenderManager made, kept apart from s_render and the
+/// libraries until the thread finishing the creation publishes it.
+struct CreatedRenderManager {
+    RenderBackend *render = nullptr;
+    /// Whether s_library is to be the library OpenDisplay returned.
+    bool setLibrary = false;
+    /// Whether RenderManager has a Direct3D 11 device of its own.
+    bool separatePresentDevice = false;
+    bool displayOpened = false;
+    osvr::renderkit::GraphicsLibrary library;
+};
+
+// Startup: CreateRenderManagerFromUnityAsync's worker and what it made (not
+// s_render until the render thread finishes it), progress for
+// GetRenderManagerStatus, and startup-to-first-frame time.
+static std::thread s_createThread;
+static std::unique_ptr<CreatedRenderManager> s_createdRenderManager;
+static std::atomic<int> s_renderManagerStatus{kOsvrRenderManagerStatus_None};
+static std::atomic<std::int64_t> s_startupBegin{0};
+static std::atomic<std::int64_t> s_startupTime{0};
+static std::int64_t s_deviceResetStart = 0;
+static std::atomic<std::int64_t> s_lastDeviceResetRecovery{0};
+/// Swap chain length requested through SetEyeBufferCount, and the one
+/// ConstructRenderBuffers last built (0 = Unity provides the eye textures).
+static int s_requestedSwapChainLength = 0;
+static int s_swapChainLength = 0;
+/// Registered copies of each eye, eye-major, when frames are presented from
+/// plugin-owned copies: one set per frame that may be presenting at once, so
+/// the render thread never writes a copy still being presented (0 = Unity's
+/// textures or a swap chain are registered instead).
+static int s_eyeCopySets = 0;
+/// Fixed foveation requested through SetFixedFoveation: the fraction of each
+/// eye's width and height rendered at full density (0 = off), and the
+/// density of the periphery.
+static double s_foveationCenterFraction = 0;
+static double s_foveationPeripheryScale = 1;
+/// Per-eye region layout of foveated buffers, set by ConstructRenderBuffers;
+/// empty unless the buffers are foveated.
+struct FoveatedEye {
+    /// Eye buffer size, in pixels.
+    double width = 0;
+    double height = 0;
+    /// Where the center region goes in the eye buffer, in pixels.
+    osvr::renderkit::OSVR_ViewportDescription center = {};
+    /// Periphery region size (it covers the whole eye), in pixels.
+    double peripheryWidth = 0;
+    double peripheryHeight = 0;
+};
+static std::vector<FoveatedEye> s_foveatedEyes;
+/// Guards s_foveatedEyes and s_openGLFoveatedEyes: Unity's main thread reads
+/// them through the GetFoveatedRegion* exports, and the render thread
+/// stitches from them, while the buffers may be rebuilt or released.
+static std::mutex s_foveationMutex;
+/// Whether s_foveatedEyes is non-empty, for the per-frame checks that don't
+/// need the layouts themselves; only ever changed under s_foveationMutex.
+static std::atomic<bool> s_foveatedBuffers{false};
+
+/// Region layout of one foveated eye: the center region is centered on the
+/// eye's optical axis (where its projection crosses zero), kept inside the
+/// eye, and snapped to whole pixels.
+inline FoveatedEye ComputeFoveatedEye(const osvr::renderkit::RenderInfo &ri) {
+    FoveatedEye layout;
+    layout.width = ri.viewport.width;
+    layout.height = ri.viewport.height;
+    layout.peripheryWidth =
+        std::max(1.0, std::round(layout.width * s_foveationPeripheryScale));
+    layout.peripheryHeight =
+        std::max(1.0, std::round(layout.height * s_foveationPeripheryScale));
+
+    const auto &p = ri.projection;
+    auto &c = layout.center;
+    c.width =
+        std::max(1.0, std::round(layout.width * s_foveationCenterFraction));
+    c.height =
+        std::max(1.0, std::round(layout.height * s_foveationCenterFraction));
+    const double axisX = -p.left / (p.right - p.left) * layout.width;
+    const double axisY = -p.bottom / (p.top - p.bottom) * layout.height;
+    c.left = std::min(std::max(std::round(axisX - c.width / 2), 0.0),
+                      layout.width - c.width);
+    c.lower = std::min(std::max(std::round(axisY - c.height / 2), 0.0),
+                       layout.height - c.height);
+    return layout;
+}
+/// Longest swap chain SetEyeBufferCount builds.
+static const int MaxSwapChainLength = 8;
+/// Per eye, the swap chain buffer Unity last acquired.
+static std::atomic<int> s_acquiredEyeBuffer[RenderInfoSnapshot::MaxEyes];
+/// Per eye, the acquired buffer the last update event locked in for the
+/// render events after it to present (-1: none yet).
+static std::atomic<int> s_latchedEyeBuffer[RenderInfoSnapshot::MaxEyes];
+/// Per eye and swap chain buffer, how many holders it has: the latch, and
+/// each frame presenting it. AcquireEyeBuffer never hands out a held buffer.
+static std::atomic<int> s_eyeBufferHolds[RenderInfoSnapshot::MaxEyes]
+                                        [MaxSwapChainLength];
 static std::vector<osvr::renderkit::RenderInfo> s_renderInfo;
-static std::vector<osvr::renderkit::RenderInfo> s_lastRenderInfo;
+/// Last non-empty render info, readable from any thread without locking.
+static RenderInfoSnapshot s_lastRenderInfo;
+/// Render thread's frame being presented synchronously: its copy of
+/// s_lastRenderInfo, buffers and viewports. Reserved to
+/// RenderInfoSnapshot::MaxEyes so per-frame copies never allocate.
+static PresentToken s_syncFrame;
+/// Parameters handed to PresentRenderBuffers, built once and reused every
+/// frame rather than constructed per present.
+static osvr::renderkit::RenderManager::RenderParams s_presentParams;
+/// Per-buffer normalized viewports at full resolution: empty (whole buffer)
+/// unless the eyes share a side-by-side texture. Each frame's are these,
+/// scaled by that frame's resolution scale.
+static std::vector<osvr::renderkit::OSVR_ViewportDescription>
+    s_croppingViewports;
 static osvr::renderkit::GraphicsLibrary s_library;
 static void *s_leftEyeTexturePtr = nullptr;
 static void *s_rightEyeTexturePtr = nullptr;
+/// With a stereo layout, both eye texture pointers are the same texture.
+static EyeBufferLayouts s_eyeBufferLayout = kOsvrEyeBufferLayout_Separate;
 /// @todo is this redundant? (given renderParams)
 static double s_nearClipDistance = 0.1;
 /// @todo is this redundant? (given renderParams)
@@ -102,57 +301,388 @@ static std::streambuf *s_oldCerr = nullptr;
 // D3D11 vars
 #if SUPPORT_D3D11
 static D3D11_TEXTURE2D_DESC s_textureDesc;
+/// Per-eye 2D textures RenderManager reads from instead of Unity's: needed
+/// when Unity renders into a texture array (RenderManager can only sample
+/// plain 2D textures); nullptr otherwise.
+static std::vector<ID3D11Texture2D *> s_eyeCopiesD3D11;
+/// Set when RenderManager was created on a device of its own, because a
+/// plugin thread presents: that thread then never touches Unity's immediate
+/// context, which only Unity's render thread may use. s_presentLibrary is
+/// RenderManager's device and context.
+static bool s_separatePresentDeviceD3D11 = false;
+static osvr::renderkit::GraphicsLibrary s_presentLibrary;
+/// One copy of an eye for presenting from RenderManager's device: a texture
+/// on Unity's device, shared with RenderManager's, and each side's keyed
+/// mutex for it. The key says whose turn it is.
+struct SharedEyeCopyD3D11 {
+    ID3D11Texture2D *texture = nullptr;
+    IDXGIKeyedMutex *mutex = nullptr;
+    ID3D11Texture2D *presentTexture = nullptr;
+    IDXGIKeyedMutex *presentMutex = nullptr;
+};
+static const UINT64 RenderThreadKey = 0;
+static const UINT64 PresentThreadKey = 1;
+/// Parallel to s_renderBuffers while those are shared eye copies.
+static std::vector<SharedEyeCopyD3D11> s_sharedEyeCopiesD3D11;
 #endif // SUPPORT_D3D11
 
 // OpenGL vars
 #if SUPPORT_OPENGL
-GLuint s_frameBuffer;
-#endif // SUPPORT_OPENGL
-
-// RenderEvents
-// Called from Unity with GL.IssuePluginEvent
-enum RenderEvents {
-    kOsvrEventID_Render = 0,
-    kOsvrEventID_Shutdown = 1,
-    kOsvrEventID_Update = 2,
-    kOsvrEventID_SetRoomRotationUsingHead = 3,
-    kOsvrEventID_ClearRoomToWorldTransform = 4
+/// Set once glewInit has run for the current device; reset on shutdown.
+static bool s_openGLInitialized = false;
+
+/// What we know about a Unity eye texture, recorded once by
+/// SetColorBufferFromUnity so the render path never has to query it.
+struct OpenGLTextureInfo {
+    GLuint name = 0;
+    /// GL_TEXTURE_2D, or GL_TEXTURE_2D_ARRAY with this eye in @c layer.
+    GLenum target = GL_TEXTURE_2D;
+    GLint layer = 0;
+    GLint internalFormat = 0;
+    GLsizei width = 0;
+    GLsizei height = 0;
 };
+/// Left and right eye texture info, matching s_left/rightEyeTexturePtr.
+static OpenGLTextureInfo s_openGLEyeTextures[2];
+
+/// Per-eye copy of a Unity texture that isn't RGBA8. target == 0 means the
+/// Unity texture is registered with RenderManager directly (no copy).
+/// The framebuffers have their attachments set, and checked for
+/// completeness, once when the copy is created.
+struct OpenGLEyeCopy {
+    OpenGLTextureInfo source;
+    GLuint target = 0;
+    GLuint readFrameBuffer = 0;
+    GLuint drawFrameBuffer = 0;
+    bool complete = false;
+};
+static std::vector<OpenGLEyeCopy> s_openGLEyeCopies;
+
+/// Per eye, the textures Unity renders the foveated regions into (indexed
+/// by FoveatedRegions), and framebuffers for stitching them into the eye
+/// buffer RenderManager presents.
+struct OpenGLFoveatedEye {
+    GLuint eyeTexture = 0;
+    GLuint eyeFrameBuffer = 0;
+    GLuint regionTextures[2] = {};
+    GLuint regionFrameBuffers[2] = {};
+};
+static std::vector<OpenGLFoveatedEye> s_openGLFoveatedEyes;
+#endif // SUPPORT_OPENGL
 
-// Mutex provides thread safety when accessing s_lastRenderInfo from Unity
-std::mutex m_mutex;
+// Frame timing instrumentation, polled by Unity through GetFrameTimings.
+static TimingRingBuffer<OSVR_FrameTiming, 256> s_frameTimings;
+/// When UpdateRenderInfo last fetched poses from RenderManager.
+static std::atomic<std::int64_t> s_lastPoseFetchTime{0};
+static std::uint64_t s_presentedFrames = 0;
+
+// Asynchronous present: frames in flight requested through SetAsyncPresent
+// (0 = present synchronously on the render thread), and the present thread,
+// which the render thread starts/stops to match.
+static std::atomic<int> s_requestedFramesInFlight{0};
+static std::unique_ptr<AsyncPresenter> s_asyncPresenter;
+
+// The present and timewarp threads are only ever started and stopped on the
+// render thread: the thread of the latest render or device event. Other
+// threads that must release what they present with hold a
+// PresentThreadsPause, which the render thread honours by stopping them
+// (s_presentThreadsStopped) and presenting nothing until the pause is over.
+// The count and flag change only under the mutex.
+static std::atomic<std::thread::id> s_renderThread{std::thread::id()};
+static std::mutex s_presentThreadsMutex;
+static std::condition_variable s_presentThreadsStopped;
+static std::atomic<int> s_presentThreadPauses{0};
+static std::atomic<bool> s_presentThreadsRunning{false};
+/// How long another thread waits for the render thread to stop it: a few
+/// frames at any refresh rate.
+static const std::chrono::milliseconds PresentThreadsStopTimeout(1000);
+
+// Asynchronous timewarp: requested through SetAsyncTimewarp, started/stopped
+// by the render thread, and counts of what the timewarp thread presented.
+static std::atomic<bool> s_asyncTimewarpRequested{false};
+static std::unique_ptr<AsyncTimewarp> s_asyncTimewarp;
+static std::atomic<std::uint64_t> s_freshFrames{0};
+static std::atomic<std::uint64_t> s_reprojectedFrames{0};
+
+// Dynamic resolution: settings from SetDynamicResolution (guarded by the
+// mutex, picked up by the render thread when changed), the render thread's
+// controller, and its output. The scale a frame renders and presents with is
+// latched with the frame's poses in UpdateRenderInfo.
+static std::mutex s_dynamicResolutionMutex;
+static bool s_dynamicResolutionEnabled = false;
+static DynamicResolutionConfig s_dynamicResolutionConfig;
+static std::atomic<bool> s_dynamicResolutionChanged{false};
+static std::unique_ptr<DynamicResolutionController> s_dynamicResolution;
+static std::int64_t s_lastRenderEventTime = 0;
+static std::atomic<double> s_nextResolutionScale{1.0};
+static std::atomic<double> s_resolutionScale{1.0};
+
+// Serializes writers of s_renderInfo/s_lastRenderInfo (render thread update
+// events vs. main thread setup calls). Readers never take it.
+static std::mutex s_renderInfoWriterMutex;
+
+// Hidden area meshes for each eye, built on request from the display
+// descriptor's lens distortion. s_hiddenAreaMeshContext is the client
+// context it was last read from; cleared on shutdown so the next
+// RenderManager's display is checked again. The descriptor is only reread
+// when the render info's viewports differ from s_hiddenAreaMeshViewports,
+// and the meshes only rebuilt when the distortion it gives differs.
+static std::mutex s_hiddenAreaMeshMutex;
+static OSVR_ClientContext s_hiddenAreaMeshContext = nullptr;
+static std::array<osvr::renderkit::OSVR_ViewportDescription,
+                  RenderInfoSnapshot::MaxEyes>
+    s_hiddenAreaMeshViewports;
+static std::size_t s_hiddenAreaMeshViewportCount = 0;
+static std::string s_hiddenAreaMeshDescriptor;
+static std::vector<LensDistortion> s_hiddenAreaMeshDistortions;
+static std::vector<HiddenAreaMesh> s_hiddenAreaMeshes;
 
 // --------------------------------------------------------------------------
 // Helper utilities
 
 // Allow writing to the Unity debug console from inside DLL land.
-static DebugFnPtr s_debugLog = nullptr;
+static std::atomic<DebugFnPtr> s_debugLog(nullptr);
 void UNITY_INTERFACE_API LinkDebug(DebugFnPtr d) { s_debugLog = d; }
 
-// Only for debugging purposes, as this causes some errors at shutdown
-inline void DebugLog(const char *str) {
-#if !defined(NDEBUG) || defined(ENABLE_LOGGING)
-    if (s_debugLog != nullptr) {
-        s_debugLog(str);
+/// Hands one log record to Unity and the log file: on the log drain thread,
+/// or on whichever thread calls FlushLog.
+inline void DeliverLogRecord(const LogRecord &record) {
+    const auto debugLog = s_debugLog.load();
+    if (debugLog != nullptr) {
+        if (record.level >= LogLevel::Error) {
+            std::string text = "Error: ";
+            text += record.text;
+            debugLog(text.c_str());
+        } else {
+            debugLog(record.text);
+        }
+    }
+
+#if defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
+    if (s_debugLogFile) {
+        static const char *const levels[] = {"T", "D", "I", "W", "E"};
+        s_debugLogFile << record.time << ' '
+                       << levels[static_cast<int>(record.level)] << ' '
+                       << record.text << '\n';
+        if (record.level >= LogLevel::Error) {
+            s_debugLogFile.flush();
+        }
     }
-#endif // !defined(NDEBUG) || defined(ENABLE_LOGGING)
+#endif // defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
+}
 
+/// Pushes delivered records out to the log file. Only AsyncLog calls it,
+/// after a delivery and before the next, so it never races the writes.
+inline void SyncLogFile() {
 #if defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
     if (s_debugLogFile) {
-        s_debugLogFile << str << std::endl;
+        s_debugLogFile.flush();
     }
 #endif // defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
 }
 
+/// Logging never blocks the caller (notably the render thread): records are
+/// queued and delivered by the drain thread, started on plugin load.
+static AsyncLog s_log(DeliverLogRecord, SyncLogFile);
+static const std::chrono::milliseconds LogDrainInterval(50);
+
+/// Queue a log record; compiled out below OSVR_RP_MIN_LOG_LEVEL.
+template <LogLevel Level> inline void PluginLog(const char *str) {
+    if (static_cast<int>(Level) >= OSVR_RP_MIN_LOG_LEVEL) {
+        s_log.push(Level, str);
+    }
+}
+
+inline void DebugLog(const char *str) { PluginLog<LogLevel::Info>(str); }
+
+void UNITY_INTERFACE_API FlushLog() { s_log.flush(true); }
+
+uint64_t UNITY_INTERFACE_API GetDroppedLogRecordCount() {
+    return s_log.dropped();
+}
+
+inline void ReleaseHeadInterface() {
+    if (s_headInterface != nullptr) {
+        osvrClientFreeInterface(s_clientContext, s_headInterface);
+        s_headInterface = nullptr;
+    }
+    // The prediction interfaces belong to the same client context.
+    for (std::size_t i = 0; i < PosePredictor::MaxDevices; ++i) {
+        if (s_predictedInterfaces[i] != nullptr) {
+            osvrClientFreeInterface(s_clientContext, s_predictedInterfaces[i]);
+            s_predictedInterfaces[i] = nullptr;
+        }
+        s_posePredictor.reset(i);
+    }
+    s_predictedDeviceCount = 1;
+    s_predictionEpoch = OSVR_TimeValue();
+    s_lastPredictionTarget.store(0, std::memory_order_relaxed);
+}
+
+/// Update event: lock in the swap chain buffer Unity last acquired for each
+/// of @p eyes eyes, holding it until an update locks in another.
+inline void LatchEyeBuffers(std::size_t eyes) {
+    if (s_swapChainLength <= 0) {
+        return;
+    }
+    for (std::size_t eye = 0; eye < eyes && eye < RenderInfoSnapshot::MaxEyes;
+         ++eye) {
+        const int acquired =
+            s_acquiredEyeBuffer[eye].load(std::memory_order_acquire);
+        s_eyeBufferHolds[eye][acquired].fetch_add(1,
+                                                  std::memory_order_relaxed);
+        const int previous = s_latchedEyeBuffer[eye].exchange(acquired);
+        if (previous >= 0) {
+            s_eyeBufferHolds[eye][previous].fetch_sub(
+                1, std::memory_order_release);
+        }
+    }
+}
+
+/// Once @p frame has been presented for the last time: let go of the swap
+/// chain buffers it held, so AcquireEyeBuffer may hand them out again.
+inline void ReleaseFrameEyeBuffers(PresentToken &frame) {
+    for (std::size_t eye = 0; eye < frame.eyeBuffers.size(); ++eye) {
+        s_eyeBufferHolds[eye][frame.eyeBuffers[eye]].fetch_sub(
+            1, std::memory_order_release);
+    }
+    frame.eyeBuffers.clear();
+}
+
+/// With no frames in flight: no buffer is latched or held any more.
+inline void ClearEyeBufferHolds() {
+    for (std::size_t eye = 0; eye < RenderInfoSnapshot::MaxEyes; ++eye) {
+        s_latchedEyeBuffer[eye].store(-1, std::memory_order_relaxed);
+        for (auto &holds : s_eyeBufferHolds[eye]) {
+            holds.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+inline void StopPresentThreads();
+inline void SelectGraphicsBackend(UnityRendererType renderer);
+
+inline bool OnRenderThread() {
+    return std::this_thread::get_id() == s_renderThread.load();
+}
+
+/// Keeps the present and timewarp threads stopped while it exists, so the
+/// buffers and RenderManager they present with may be released. On the
+/// render thread they are stopped at once. Any other thread waits, at most
+/// PresentThreadsStopTimeout, for the render thread to stop them at its next
+/// render event.
+class PresentThreadsPause {
+  public:
+    PresentThreadsPause() {
+        std::unique_lock<std::mutex> lock(s_presentThreadsMutex);
+        ++s_presentThreadPauses;
+        if (OnRenderThread()) {
+            lock.unlock();
+            StopPresentThreads();
+            stopped_ = true;
+            return;
+        }
+        stopped_ = s_presentThreadsStopped.wait_for(
+            lock, PresentThreadsStopTimeout,
+            [] { return !s_presentThreadsRunning.load(); });
+    }
+    ~PresentThreadsPause() {
+        std::lock_guard<std::mutex> lock(s_presentThreadsMutex);
+        --s_presentThreadPauses;
+    }
+    PresentThreadsPause(PresentThreadsPause const &) = delete;
+    PresentThreadsPause &operator=(PresentThreadsPause const &) = delete;
+
+    /// False if the render thread didn't stop them in time: they may still
+    /// be presenting.
+    bool stopped() const { return stopped_; }
+
+  private:
+    bool stopped_ = false;
+};
+
+/// Release the render buffers and everything created for them (views, copies,
+/// framebuffers), leaving RenderManager and its display open. The present
+/// threads may be using the buffers, so the caller must hold a stopped
+/// PresentThreadsPause; the render thread restarts them once that is over.
+inline void ReleaseRenderBuffers() {
+    if (s_renderBufferCleanup != nullptr) {
+        for (auto &rb : s_renderBuffers) {
+            s_renderBufferCleanup(rb);
+        }
+    }
+    s_renderBuffers.clear();
+    s_renderBufferCleanup = nullptr;
+    s_swapChainLength = 0;
+    ClearEyeBufferHolds();
+    s_eyeCopySets = 0;
+#if SUPPORT_D3D11
+    s_sharedEyeCopiesD3D11.clear();
+#endif // SUPPORT_D3D11
+    std::lock_guard<std::mutex> lock(s_foveationMutex);
+    s_foveatedEyes.clear();
+    s_foveatedBuffers = false;
+}
+
 void UNITY_INTERFACE_API ShutdownRenderManager() {
     DebugLog("[OSVR Rendering Plugin] Shutting down RenderManager.");
+    PresentThreadsPause pause;
+    if (!pause.stopped()) {
+        // Nothing the present thread uses may go: render events stop using
+        // RenderManager now, and the render thread finishes this.
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] The present "
+                                     "thread did not stop: RenderManager "
+                                     "will be shut down at the next render "
+                                     "event.");
+        s_renderManagerStatus = kOsvrRenderManagerStatus_None;
+        s_shutdownPending = true;
+        return;
+    }
+    std::thread createThread;
+    {
+        std::lock_guard<std::mutex> lock(s_renderManagerMutex);
+        createThread = std::move(s_createThread);
+    }
+    if (createThread.joinable()) {
+        // Can't cancel RenderManager creation, only wait it out. Not under
+        // the lock: the worker takes it to store what it made.
+        createThread.join();
+    }
+    std::lock_guard<std::mutex> lock(s_renderManagerMutex);
+    s_shutdownPending = false;
+    if (s_createdRenderManager) {
+        delete s_createdRenderManager->render;
+        s_createdRenderManager.reset();
+    }
+    s_renderManagerStatus = kOsvrRenderManagerStatus_None;
+    ReleaseRenderBuffers();
+    s_rebuildBuffersAfterReset = false;
     if (s_render != nullptr) {
+        {
+            // Wait out an update event that saw RenderManager still ready.
+            std::lock_guard<std::mutex> writerLock(s_renderInfoWriterMutex);
+        }
         delete s_render;
         s_render = nullptr;
         s_rightEyeTexturePtr = nullptr;
         s_leftEyeTexturePtr = nullptr;
+        s_eyeBufferLayout = kOsvrEyeBufferLayout_Separate;
+#if SUPPORT_D3D11
+        s_separatePresentDeviceD3D11 = false;
+        s_presentLibrary = osvr::renderkit::GraphicsLibrary();
+        SelectGraphicsBackend(s_deviceType);
+#endif // SUPPORT_D3D11
+#if SUPPORT_OPENGL
+        s_openGLEyeTextures[0] = OpenGLTextureInfo();
+        s_openGLEyeTextures[1] = OpenGLTextureInfo();
+#endif // SUPPORT_OPENGL
     }
+    ReleaseHeadInterface();
     s_clientContext = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(s_hiddenAreaMeshMutex);
+        s_hiddenAreaMeshContext = nullptr;
+    }
 }
 
 // --------------------------------------------------------------------------
@@ -176,6 +706,7 @@ inline void DoEventGraphicsDeviceD3D11(UnityGfxDeviceEventType eventType) {
 
         // Put the device and context into a structure to let RenderManager
         // know to use this one rather than creating its own.
+        delete s_library.D3D11;
         s_library.D3D11 = new osvr::renderkit::GraphicsLibraryD3D11;
         s_library.D3D11->device = d3d11->GetDevice();
         ID3D11DeviceContext *ctx = nullptr;
@@ -186,19 +717,61 @@ inline void DoEventGraphicsDeviceD3D11(UnityGfxDeviceEventType eventType) {
         break;
     }
     case kUnityGfxDeviceEventShutdown: {
-        // Close the Renderer interface cleanly.
-        // This should be handled in ShutdownRenderManager
-        /// @todo delete library.D3D11; library.D3D11 = nullptr; ?
+        // Close the Renderer interface cleanly, if the game didn't: it uses
+        // the device and context we're about to let go of.
+        if (s_render != nullptr) {
+            ShutdownRenderManager();
+        }
+        if (s_library.D3D11 != nullptr) {
+            // GetImmediateContext added a reference; the device is Unity's.
+            if (s_library.D3D11->context != nullptr) {
+                s_library.D3D11->context->Release();
+            }
+            delete s_library.D3D11;
+            s_library.D3D11 = nullptr;
+        }
+        break;
+    }
+    case kUnityGfxDeviceEventAfterReset: {
+        // RenderManager's own resources live on the device it was given, so
+        // an incremental rebuild is only possible if it survived the reset.
+        IUnityGraphicsD3D11 *d3d11 =
+            s_UnityInterfaces->Get<IUnityGraphicsD3D11>();
+        if (s_rebuildBuffersAfterReset && s_library.D3D11 != nullptr &&
+            d3d11->GetDevice() != s_library.D3D11->device) {
+            PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Direct3D "
+                                         "device changed across reset: call "
+                                         "ShutdownRenderManager and "
+                                         "CreateRenderManagerFromUnity again.");
+            s_rebuildBuffersAfterReset = false;
+        }
         break;
     }
+    default:
+        break;
     }
 }
 #endif // SUPPORT_D3D11
 
 #if SUPPORT_OPENGL
+/// One-time per-device OpenGL setup. Safe to call repeatedly.
+inline bool InitializeOpenGL() {
+    if (s_openGLInitialized) {
+        return true;
+    }
+    glewExperimental = 1u;
+    /// @todo doesn't rendermanager do this glewInit for us?
+    GLenum err = glewInit();
+    if (err != GLEW_OK) {
+        PluginLog<LogLevel::Error>("glewInit failed, aborting.");
+        return false;
+    }
+    s_openGLInitialized = true;
+    return true;
+}
+
 // -------------------------------------------------------------------
 /// OpenGL setup/teardown code
-/// @todo OpenGL path not implemented yet
 inline void DoEventGraphicsDeviceOpenGL(UnityGfxDeviceEventType eventType) {
     BOOST_ASSERT_MSG(
         s_deviceType,
@@ -209,10 +782,12 @@ inline void DoEventGraphicsDeviceOpenGL(UnityGfxDeviceEventType eventType) {
 
     switch (eventType) {
     case kUnityGfxDeviceEventInitialize:
-        DebugLog("OpenGL Initialize Event");
+        PluginLog<LogLevel::Debug>("OpenGL Initialize Event");
+        InitializeOpenGL();
         break;
     case kUnityGfxDeviceEventShutdown:
-        DebugLog("OpenGL Shutdown Event");
+        PluginLog<LogLevel::Debug>("OpenGL Shutdown Event");
+        s_openGLInitialized = false;
         break;
     default:
         break;
@@ -223,24 +798,11 @@ inline void DoEventGraphicsDeviceOpenGL(UnityGfxDeviceEventType eventType) {
 inline void dispatchEventToRenderer(UnityRendererType renderer,
                                     UnityGfxDeviceEventType eventType) {
     if (!renderer) {
-        DebugLog("[OSVR Rendering Plugin] Current device type not supported");
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Current device "
+                                     "type not supported");
         return;
     }
-    switch (renderer.getDeviceTypeEnum()) {
-#if SUPPORT_D3D11
-    case OSVRSupportedRenderers::D3D11:
-        DoEventGraphicsDeviceD3D11(eventType);
-        break;
-#endif
-#if SUPPORT_OPENGL
-    case OSVRSupportedRenderers::OpenGL:
-        DoEventGraphicsDeviceOpenGL(eventType);
-        break;
-#endif
-    case OSVRSupportedRenderers::EmptyRenderer:
-    default:
-        break;
-    }
+    s_backend.load()->deviceEvent(eventType);
 }
 
 /// Needs the calling convention, even though it's static and not exported,
@@ -252,10 +814,14 @@ OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType) {
         DebugLog(
             "[OSVR Rendering Plugin] OnGraphicsDeviceEvent(Initialize).\n");
         s_deviceType = s_Graphics->GetRenderer();
+        if (!s_deviceType && usingHeadlessRenderBackend()) {
+            s_deviceType.setHeadless();
+        }
+        SelectGraphicsBackend(s_deviceType);
         if (!s_deviceType) {
-            DebugLog("[OSVR Rendering Plugin] "
-                     "OnGraphicsDeviceEvent(Initialize): New device type is "
-                     "not supported!\n");
+            PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] "
+                                         "OnGraphicsDeviceEvent(Initialize): "
+                                         "New device type is not supported!\n");
         }
         break;
     }
@@ -266,19 +832,43 @@ OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType) {
         /// right device type gets shut down. Thus we return instead of break.
         dispatchEventToRenderer(s_deviceType, eventType);
         s_deviceType.reset();
+        SelectGraphicsBackend(s_deviceType);
         return;
     }
 
     case kUnityGfxDeviceEventBeforeReset: {
         DebugLog(
             "[OSVR Rendering Plugin] OnGraphicsDeviceEvent(BeforeReset).\n");
+        // Only device-dependent resources go; RenderManager and the display
+        // stay up.
+        s_deviceResetStart = FrameTimingNow();
+        s_rebuildBuffersAfterReset =
+            s_render != nullptr && !s_renderBuffers.empty();
+        // Device events come on the render thread, which stops the present
+        // thread right here.
+        PresentThreadsPause pause;
+        ReleaseRenderBuffers();
         break;
     }
 
     case kUnityGfxDeviceEventAfterReset: {
         DebugLog(
             "[OSVR Rendering Plugin] OnGraphicsDeviceEvent(AfterReset).\n");
-        break;
+        // Let the renderer check its device first: it may veto the rebuild.
+        dispatchEventToRenderer(s_deviceType, eventType);
+        if (s_rebuildBuffersAfterReset) {
+            s_rebuildBuffersAfterReset = false;
+            if (ConstructRenderBuffers() == OSVR_RETURN_SUCCESS) {
+                s_lastDeviceResetRecovery.store(FrameTimingNow() -
+                                                    s_deviceResetStart,
+                                                std::memory_order_relaxed);
+            } else {
+                PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not "
+                                           "rebuild render buffers after "
+                                           "device reset.");
+            }
+        }
+        return;
     }
     }
 
@@ -300,6 +890,7 @@ void UNITY_INTERFACE_API UnityPluginLoad(IUnityInterfaces *unityInterfaces) {
         std::cerr.rdbuf(s_debugLogFile.rdbuf());
     }
 #endif // defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
+    s_log.startDrainThread(LogDrainInterval);
     s_UnityInterfaces = unityInterfaces;
     s_Graphics = s_UnityInterfaces->Get<IUnityGraphics>();
     s_Graphics->RegisterDeviceEventCallback(OnGraphicsDeviceEvent);
@@ -311,6 +902,9 @@ void UNITY_INTERFACE_API UnityPluginLoad(IUnityInterfaces *unityInterfaces) {
 void UNITY_INTERFACE_API UnityPluginUnload() {
     s_Graphics->UnregisterDeviceEventCallback(OnGraphicsDeviceEvent);
     OnGraphicsDeviceEvent(kUnityGfxDeviceEventShutdown);
+    s_poseTrace.close();
+    // Delivers whatever is still queued.
+    s_log.stopDrainThread();
 
 #if defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
     if (s_debugLogFile) {
@@ -322,13 +916,125 @@ void UNITY_INTERFACE_API UnityPluginUnload() {
 #endif // defined(ENABLE_LOGGING) && defined(ENABLE_LOGFILE)
 }
 
+/// Sample every predicted device and extrapolate them all to the expected
+/// display time, which is returned in @p target. Called with
+/// s_renderInfoWriterMutex held.
+/// @return false if prediction is off or there is no head pose.
+inline bool PredictPoses(OSVR_PoseState &headPose, double &target) {
+    double lead = s_predictionLeadTime.load(std::memory_order_relaxed);
+    if (lead < 0) {
+        lead = s_measuredDisplayLatency.load(std::memory_order_relaxed);
+    }
+    if (lead == 0 || s_clientContext == nullptr) {
+        return false;
+    }
+
+    if (s_predictedInterfaces[0] == nullptr &&
+        osvrClientGetInterface(s_clientContext, "/me/head",
+                               &s_predictedInterfaces[0]) !=
+            OSVR_RETURN_SUCCESS) {
+        s_predictedInterfaces[0] = nullptr;
+        return false;
+    }
+    osvrClientUpdate(s_clientContext);
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    if (s_predictionEpoch.seconds == 0) {
+        // Keep times small so doubles keep sub-microsecond precision.
+        s_predictionEpoch = now;
+    }
+    for (std::size_t i = 0; i < s_predictedDeviceCount; ++i) {
+        OSVR_TimeValue timestamp;
+        OSVR_PoseState pose;
+        if (s_predictedInterfaces[i] != nullptr &&
+            osvrGetPoseState(s_predictedInterfaces[i], &timestamp, &pose) ==
+                OSVR_RETURN_SUCCESS) {
+            s_posePredictor.addSample(
+                i, osvrTimeValueDurationSeconds(&timestamp, &s_predictionEpoch),
+                pose);
+        }
+    }
+
+    target = osvrTimeValueDurationSeconds(&now, &s_predictionEpoch) + lead;
+    std::lock_guard<std::mutex> lock(s_predictedPosesMutex);
+    s_posePredictor.predictAll(target, s_predictedPoses,
+                               s_predictedDeviceCount);
+    if (!s_posePredictor.hasSamples(0)) {
+        return false;
+    }
+    headPose = s_predictedPoses[0];
+    return true;
+}
+
+/// Record each eye of a GetRenderInfo result, if a pose trace is running.
+inline void TraceRenderInfo(
+    const std::vector<osvr::renderkit::RenderInfo> &renderInfo,
+    std::int64_t time) {
+    if (!s_poseTrace.isOpen()) {
+        return;
+    }
+    PoseTraceRenderInfo record = {};
+    record.header.type = kPoseTraceRecord_RenderInfo;
+    record.header.time = time;
+    for (std::size_t eye = 0; eye < renderInfo.size(); ++eye) {
+        const auto &ri = renderInfo[eye];
+        record.eye = static_cast<std::uint32_t>(eye);
+        std::copy(ri.pose.translation.data, ri.pose.translation.data + 3,
+                  record.translation);
+        std::copy(ri.pose.rotation.data, ri.pose.rotation.data + 4,
+                  record.rotation);
+        record.projection[0] = ri.projection.left;
+        record.projection[1] = ri.projection.right;
+        record.projection[2] = ri.projection.top;
+        record.projection[3] = ri.projection.bottom;
+        record.projection[4] = ri.projection.nearClip;
+        record.projection[5] = ri.projection.farClip;
+        record.viewport[0] = ri.viewport.left;
+        record.viewport[1] = ri.viewport.lower;
+        record.viewport[2] = ri.viewport.width;
+        record.viewport[3] = ri.viewport.height;
+        s_poseTrace.append(record);
+    }
+}
+
+/// s_render may only be used once the status says it is ready: until then a
+/// creation worker may still be building it, and s_render is null.
+inline bool RenderManagerReady() {
+    return s_renderManagerStatus.load() == kOsvrRenderManagerStatus_Ready;
+}
+
 inline void UpdateRenderInfo() {
-	std::lock_guard<std::mutex> lock(m_mutex);
-    s_renderInfo = s_render->GetRenderInfo(s_renderParams);
-	if (s_renderInfo.size() > 0)
-	{
-		s_lastRenderInfo = s_renderInfo;
-	}
+    if (!RenderManagerReady()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(s_renderInfoWriterMutex);
+    // Again, now that ShutdownRenderManager can't be deleting s_render.
+    if (!RenderManagerReady()) {
+        return;
+    }
+    OSVR_PoseState predictedHead;
+    double target = 0;
+    const bool predicted = PredictPoses(predictedHead, target);
+    // Unity renders with the eye poses for the predicted head pose.
+    s_renderParams.roomFromHeadReplace = predicted ? &predictedHead : nullptr;
+    // In place, like the snapshot; only the real RenderManager still
+    // allocates here (see RenderManagerBackend).
+    s_render->GetRenderInfo(s_renderParams, s_renderInfo);
+    s_renderParams.roomFromHeadReplace = nullptr;
+    if (s_renderInfo.size() > 0) {
+        s_resolutionScale.store(
+            s_nextResolutionScale.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        const auto now = FrameTimingNow();
+        s_lastPoseFetchTime.store(now, std::memory_order_relaxed);
+        s_lastPredictionTarget.store(predicted ? target : 0,
+                                     std::memory_order_relaxed);
+        s_lastRenderInfo.publish(s_renderInfo);
+        // Unity rendered this frame into the buffers it acquired before now;
+        // later acquisitions are for the next frame.
+        LatchEyeBuffers(s_renderInfo.size());
+        TraceRenderInfo(s_renderInfo, now);
+    }
 }
 
 #if 0
@@ -381,25 +1087,54 @@ void SetRoomRotationUsingHead() { /*s_render->SetRoomRotationUsingHead();*/ }
 // DEPRECATED
 void ClearRoomToWorldTransform() { /*s_render->ClearRoomToWorldTransform();*/ }
 
+/// Whether a ShutdownRenderManager is still waiting for the render thread to
+/// finish it, so no RenderManager may be created yet (logged).
+inline bool ShutdownStillPending() {
+    if (!s_shutdownPending) {
+        return false;
+    }
+    PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] The last "
+                               "ShutdownRenderManager is waiting for a "
+                               "render event: issue kOsvrEventID_Shutdown "
+                               "before creating RenderManager again.");
+    return true;
+}
+
 // Called from Unity to create a RenderManager, passing in a ClientContext
-OSVR_ReturnCode UNITY_INTERFACE_API
-CreateRenderManagerFromUnity(OSVR_ClientContext context) {
+/// Common start of both CreateRenderManagerFromUnity variants.
+/// @return true if RenderManager is already created and doing OK, so there
+/// is nothing more to do.
+inline bool BeginCreateRenderManager(OSVR_ClientContext context) {
+    RenderBackend *render = nullptr;
+    bool createUnfinished = false;
+    {
+        std::lock_guard<std::mutex> lock(s_renderManagerMutex);
+        render = s_render;
+        createUnfinished =
+            s_createThread.joinable() || s_createdRenderManager != nullptr;
+    }
     /// See if we're already created/running - shouldn't happen, but might.
-    if (s_render != nullptr) {
-        if (s_render->doingOkay()) {
+    if (render != nullptr) {
+        if (render->doingOkay()) {
             DebugLog("[OSVR Rendering Plugin] RenderManager already created "
                      "and doing OK - will just return success without trying "
                      "to re-initialize.");
-            return OSVR_RETURN_SUCCESS;
+            s_renderManagerStatus = kOsvrRenderManagerStatus_Ready;
+            return true;
         }
 
         DebugLog("[OSVR Rendering Plugin] RenderManager already created, "
                  "but not doing OK. Will shut down before creating again.");
         ShutdownRenderManager();
+    } else if (createUnfinished) {
+        DebugLog("[OSVR Rendering Plugin] Abandoning an unfinished "
+                 "asynchronous RenderManager creation.");
+        ShutdownRenderManager();
     }
     if (s_clientContext != nullptr) {
         DebugLog(
             "[OSVR Rendering Plugin] Client context already set! Replacing...");
+        ReleaseHeadInterface();
     }
     s_clientContext = context;
 
@@ -411,64 +1146,212 @@ CreateRenderManagerFromUnity(OSVR_ClientContext context) {
 		// the platform from Unity than assume it's D3D11.
 
 		s_deviceType = kUnityGfxRendererD3D11;
+        SelectGraphicsBackend(s_deviceType);
 
        /* DebugLog("[OSVR Rendering Plugin] Attempted to create render manager, "
                  "but device type wasn't set (to a supported type) by the "
                  "plugin load/init routine. Order issue?");
         return OSVR_RETURN_FAILURE;*/
     }
+    // Only now is a RenderManager actually being created.
+    s_startupBegin.store(FrameTimingNow());
+    return false;
+}
 
-    bool setLibraryFromOpenDisplayReturn = false;
+/// Create the backend for the current device type into @p created. Any
+/// thread: sets nothing the other threads read.
+/// @return false on failure.
+inline bool CreateBackendForDevice(OSVR_ClientContext context,
+                                   CreatedRenderManager &created) {
+    RenderBackend *render = nullptr;
     /// @todo We should always have a legit value in
     /// s_deviceType.getDeviceTypeEnum() at this point, right?
     switch (s_deviceType.getDeviceTypeEnum()) {
 
 #if SUPPORT_D3D11
     case OSVRSupportedRenderers::D3D11:
-        s_render = osvr::renderkit::createRenderManager(context, "Direct3D11",
-                                                        s_library);
+        // Asynchronous present and timewarp need RenderManager on a device
+        // of its own: it is decided here, so SetAsyncPresent or
+        // SetAsyncTimewarp must come first.
+        created.separatePresentDevice =
+            s_requestedFramesInFlight.load(std::memory_order_relaxed) > 0 ||
+            s_asyncTimewarpRequested.load(std::memory_order_relaxed);
+        render = created.separatePresentDevice
+                     ? createRenderBackend(context, "Direct3D11")
+                     : createRenderBackend(context, "Direct3D11", s_library);
 #ifdef ATTEMPT_D3D_SHARING
-        setLibraryFromOpenDisplayReturn = true;
+        created.setLibrary = true;
 #endif // ATTEMPT_D3D_SHARING
         break;
 #endif // SUPPORT_D3D11
 
 #if SUPPORT_OPENGL
     case OSVRSupportedRenderers::OpenGL:
-        s_render = osvr::renderkit::createRenderManager(context, "OpenGL");
-        setLibraryFromOpenDisplayReturn = true;
+        render = createRenderBackend(context, "OpenGL");
+        created.setLibrary = true;
         break;
 #endif // SUPPORT_OPENGL
-    }
 
-    if ((s_render == nullptr) || (!s_render->doingOkay())) {
-        DebugLog("[OSVR Rendering Plugin] Could not create RenderManager");
+    case OSVRSupportedRenderers::Headless:
+        render = createRenderBackend(context, "Headless");
+        break;
+    }
 
-        ShutdownRenderManager();
-        return OSVR_RETURN_FAILURE;
+    if ((render == nullptr) || (!render->doingOkay())) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not create "
+                                   "RenderManager");
+        delete render;
+        return false;
     }
+    created.render = render;
+    return true;
+}
 
-    // Open the display and make sure this worked.
-    osvr::renderkit::RenderManager::OpenResults ret = s_render->OpenDisplay();
+/// Open the display of @p created and make sure this worked.
+inline bool OpenDisplay(CreatedRenderManager &created) {
+    osvr::renderkit::RenderManager::OpenResults ret =
+        created.render->OpenDisplay();
     if (ret.status == osvr::renderkit::RenderManager::OpenStatus::FAILURE) {
-        DebugLog("[OSVR Rendering Plugin] Could not open display");
-
-        ShutdownRenderManager();
-        return OSVR_RETURN_FAILURE;
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not open "
+                                   "display");
+        return false;
     }
-    if (setLibraryFromOpenDisplayReturn) {
+    created.library = ret.library;
+    created.displayOpened = true;
+    return true;
+}
+
+/// Make what was created, its display open, the plugin's RenderManager.
+/// On the thread finishing the creation.
+inline void PublishRenderManager(CreatedRenderManager const &created) {
+    if (created.setLibrary) {
         // Set our library from the one RenderManager created.
-        s_library = ret.library;
+        s_library = created.library;
     }
+#if SUPPORT_D3D11
+    s_separatePresentDeviceD3D11 = created.separatePresentDevice;
+    if (created.separatePresentDevice) {
+        s_presentLibrary = created.library;
+    }
+#endif // SUPPORT_D3D11
+    s_render = created.render;
+}
 
+/// Common end of both CreateRenderManagerFromUnity variants, once s_render
+/// has its display open.
+inline void EndCreateRenderManager() {
     // create a new set of RenderParams for passing to GetRenderInfo()
     s_renderParams = osvr::renderkit::RenderManager::RenderParams();
+    s_presentParams = osvr::renderkit::RenderManager::RenderParams();
+    s_renderInfo.reserve(RenderInfoSnapshot::MaxEyes);
+    s_syncFrame.renderInfo.reserve(RenderInfoSnapshot::MaxEyes);
+    s_syncFrame.renderBuffers.reserve(RenderInfoSnapshot::MaxEyes);
+    s_syncFrame.croppingViewports.reserve(RenderInfoSnapshot::MaxEyes);
+    s_syncFrame.eyeBuffers.reserve(RenderInfoSnapshot::MaxEyes);
+    // Now that it's known whether RenderManager has a device of its own.
+    SelectGraphicsBackend(s_deviceType);
+    // Publishes s_render to the other threads.
+    s_renderManagerStatus = kOsvrRenderManagerStatus_Ready;
     UpdateRenderInfo();
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API
+CreateRenderManagerFromUnity(OSVR_ClientContext context) {
+    if (ShutdownStillPending()) {
+        return OSVR_RETURN_FAILURE;
+    }
+    if (BeginCreateRenderManager(context)) {
+        return OSVR_RETURN_SUCCESS;
+    }
+
+    CreatedRenderManager created;
+    if (!CreateBackendForDevice(context, created) || !OpenDisplay(created)) {
+        delete created.render;
+        ShutdownRenderManager();
+        s_renderManagerStatus = kOsvrRenderManagerStatus_Failed;
+        return OSVR_RETURN_FAILURE;
+    }
+    PublishRenderManager(created);
+    EndCreateRenderManager();
 
     DebugLog("[OSVR Rendering Plugin] CreateRenderManagerFromUnity Success!");
     return OSVR_RETURN_SUCCESS;
 }
 
+/// CreateRenderManagerFromUnityAsync's worker thread.
+inline void CreateRenderManagerWorker(OSVR_ClientContext context) {
+    std::unique_ptr<CreatedRenderManager> created(new CreatedRenderManager);
+    if (!CreateBackendForDevice(context, *created)) {
+        s_renderManagerStatus = kOsvrRenderManagerStatus_Failed;
+        return;
+    }
+#if SUPPORT_D3D11
+    if (created->separatePresentDevice) {
+        // RenderManager has a device of its own: opening the display touches
+        // nothing of Unity's.
+        if (!OpenDisplay(*created)) {
+            delete created->render;
+            s_renderManagerStatus = kOsvrRenderManagerStatus_Failed;
+            return;
+        }
+    }
+#endif // SUPPORT_D3D11
+    // Otherwise OpenDisplay uses Unity's immediate context (Direct3D), which
+    // only Unity's render thread may, or creates contexts that must belong to
+    // the render thread (OpenGL), so that waits for
+    // kOsvrEventID_FinishCreateRenderManager.
+    {
+        std::lock_guard<std::mutex> lock(s_renderManagerMutex);
+        s_createdRenderManager = std::move(created);
+    }
+    s_renderManagerStatus = kOsvrRenderManagerStatus_WaitingForRenderThread;
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API
+CreateRenderManagerFromUnityAsync(OSVR_ClientContext context) {
+    if (ShutdownStillPending()) {
+        return OSVR_RETURN_FAILURE;
+    }
+    if (BeginCreateRenderManager(context)) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    s_renderManagerStatus = kOsvrRenderManagerStatus_Creating;
+    std::lock_guard<std::mutex> lock(s_renderManagerMutex);
+    s_createThread =
+        std::thread([context] { CreateRenderManagerWorker(context); });
+    return OSVR_RETURN_SUCCESS;
+}
+
+/// Render thread, on kOsvrEventID_FinishCreateRenderManager.
+inline void FinishCreateRenderManagerAsync() {
+    std::lock_guard<std::mutex> lock(s_renderManagerMutex);
+    if (s_renderManagerStatus !=
+            kOsvrRenderManagerStatus_WaitingForRenderThread ||
+        !s_createThread.joinable()) {
+        // Not done yet, or ShutdownRenderManager took the worker over.
+        return;
+    }
+    // The worker stored its result before setting the status: all that is
+    // left of it is returning.
+    std::thread createThread = std::move(s_createThread);
+    createThread.join();
+    std::unique_ptr<CreatedRenderManager> created =
+        std::move(s_createdRenderManager);
+    if (!created->displayOpened && !OpenDisplay(*created)) {
+        delete created->render;
+        s_renderManagerStatus = kOsvrRenderManagerStatus_Failed;
+        return;
+    }
+    PublishRenderManager(*created);
+    EndCreateRenderManager();
+    DebugLog("[OSVR Rendering Plugin] CreateRenderManagerFromUnityAsync "
+             "Success!");
+}
+
+int UNITY_INTERFACE_API GetRenderManagerStatus() {
+    return s_renderManagerStatus.load();
+}
+
 /// Helper function that handles doing the loop of constructing buffers, and
 /// returning failure if any of them in the loop return failure.
 template <typename F, typename G>
@@ -478,19 +1361,25 @@ inline OSVR_ReturnCode applyRenderBufferConstructor(const int numBuffers,
     /// If we bail any time before the end, we'll automatically clean up the
     /// render buffers with this lambda.
     auto cleanupBuffers = osvr::util::finally([&] {
-        DebugLog("[OSVR Rendering Plugin] Cleaning up render buffers.");
+        PluginLog<LogLevel::Debug>("[OSVR Rendering Plugin] Cleaning up "
+                                   "render buffers.");
         for (auto &rb : s_renderBuffers) {
             bufferCleanup(rb);
         }
         s_renderBuffers.clear();
-        DebugLog("[OSVR Rendering Plugin] Render buffer cleanup complete.");
+        PluginLog<LogLevel::Debug>("[OSVR Rendering Plugin] Render buffer "
+                                   "cleanup complete.");
     });
 
+    /// Rebuilding: let go of the previous buffers first.
+    ReleaseRenderBuffers();
+
     /// Construct all the buffers as isntructed
     for (int i = 0; i < numBuffers; ++i) {
         auto ret = bufferConstructor(i);
         if (ret != OSVR_RETURN_SUCCESS) {
-            DebugLog("[OSVR Rendering Plugin] Failed in a buffer constructor!");
+            PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Failed in a "
+                                       "buffer constructor!");
             return OSVR_RETURN_FAILURE;
         }
     }
@@ -498,97 +1387,349 @@ inline OSVR_ReturnCode applyRenderBufferConstructor(const int numBuffers,
     /// Register our constructed buffers so that we can use them for
     /// presentation.
     if (!s_render->RegisterRenderBuffers(s_renderBuffers)) {
-        DebugLog("RegisterRenderBuffers() returned false, cannot continue");
+        PluginLog<LogLevel::Error>("RegisterRenderBuffers() returned false, "
+                                   "cannot continue");
         return OSVR_RETURN_FAILURE;
     }
     /// Only if we succeed, do we cancel the cleanup and carry on.
     cleanupBuffers.cancel();
+    s_renderBufferCleanup = bufferCleanup;
     return OSVR_RETURN_SUCCESS;
 }
 
 #if SUPPORT_OPENGL
+/// Query and remember the size and format of a Unity eye texture.
+inline void RecordEyeTextureOpenGL(int eye, void *texturePtr) {
+    auto &info = s_openGLEyeTextures[eye == 0 ? 0 : 1];
+    info = OpenGLTextureInfo();
+    // On OpenGL, GetNativeTexturePtr() is the texture name cast to a pointer.
+    info.name =
+        static_cast<GLuint>(reinterpret_cast<std::uintptr_t>(texturePtr));
+    if (s_eyeBufferLayout == kOsvrEyeBufferLayout_TextureArray) {
+        info.target = GL_TEXTURE_2D_ARRAY;
+        info.layer = eye;
+    }
+    if (info.name == 0 || !InitializeOpenGL()) {
+        return;
+    }
+    const GLenum binding = info.target == GL_TEXTURE_2D_ARRAY
+                               ? GL_TEXTURE_BINDING_2D_ARRAY
+                               : GL_TEXTURE_BINDING_2D;
+    GLint previousTexture = 0;
+    glGetIntegerv(binding, &previousTexture);
+    glBindTexture(info.target, info.name);
+    glGetTexLevelParameteriv(info.target, 0, GL_TEXTURE_INTERNAL_FORMAT,
+                             &info.internalFormat);
+    glGetTexLevelParameteriv(info.target, 0, GL_TEXTURE_WIDTH, &info.width);
+    glGetTexLevelParameteriv(info.target, 0, GL_TEXTURE_HEIGHT, &info.height);
+    glBindTexture(info.target, static_cast<GLuint>(previousTexture));
+}
+
+/// Attach a texture to a framebuffer and check it's usable - done when the
+/// attachment changes, never per frame.
+inline bool AttachTextureOpenGL(GLenum target, GLuint frameBuffer,
+                                const OpenGLTextureInfo &texture) {
+    glBindFramebuffer(target, frameBuffer);
+    if (texture.target == GL_TEXTURE_2D_ARRAY) {
+        glFramebufferTextureLayer(target, GL_COLOR_ATTACHMENT0, texture.name,
+                                  0, texture.layer);
+    } else {
+        glFramebufferTexture2D(target, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               texture.name, 0);
+    }
+    return glCheckFramebufferStatus(target) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+/// A new RGBA8 texture with bilinear filtering, leaving the 2D texture
+/// binding as it was.
+inline GLuint CreateColorTextureOpenGL(GLsizei width, GLsizei height) {
+    GLint previousTexture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+    // Bilinear filtering
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previousTexture));
+    return texture;
+}
+
 inline OSVR_ReturnCode ConstructBuffersOpenGL(int eye) {
-    // Init glew
-    glewExperimental = 1u;
-    /// @todo doesn't rendermanager do this glewInit for us?
-    GLenum err = glewInit();
-    if (err != GLEW_OK) {
-        DebugLog("glewInit failed, aborting.");
-        /// @todo shouldn't we return here then?
+    if (!InitializeOpenGL()) {
+        return OSVR_RETURN_FAILURE;
     }
 
     if (eye == 0) {
-        // do this once
-        glGenFramebuffers(1, &s_frameBuffer);
-        glBindFramebuffer(GL_FRAMEBUFFER, s_frameBuffer);
+        s_openGLEyeCopies.clear();
+    }
+
+    OpenGLEyeCopy eyeCopy;
+    eyeCopy.source = s_openGLEyeTextures[eye == 0 ? 0 : 1];
+    if (eyeCopy.source.name == 0) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] No Unity texture "
+                                   "set for eye");
+        return OSVR_RETURN_FAILURE;
     }
 
     // The color buffer for this eye.  We need to put this into
     // a generic structure for the Present function, but we only need
     // to fill in the OpenGL portion.
-    if (eye == 0) // left eye
-    {
-        GLuint leftEyeColorBuffer = 0;
-        glGenRenderbuffers(1, &leftEyeColorBuffer);
-        osvr::renderkit::RenderBuffer rb;
-        rb.OpenGL = new osvr::renderkit::RenderBufferOpenGL;
-        rb.OpenGL->colorBufferName = leftEyeColorBuffer;
-        s_renderBuffers.push_back(rb);
-        // "Bind" the newly created texture : all future texture
-        // functions will modify this texture glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, leftEyeColorBuffer);
-
-        // Give an empty image to OpenGL ( the last "0" means "empty" )
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
-                     static_cast<GLsizei>(s_renderInfo[eye].viewport.width),
-                     static_cast<GLsizei>(s_renderInfo[eye].viewport.height), 0,
-                     GL_RGB, GL_UNSIGNED_BYTE, &leftEyeColorBuffer);
-    } else // right eye
-    {
-        GLuint rightEyeColorBuffer = 0;
-        glGenRenderbuffers(1, &rightEyeColorBuffer);
-        osvr::renderkit::RenderBuffer rb;
-        rb.OpenGL = new osvr::renderkit::RenderBufferOpenGL;
-        rb.OpenGL->colorBufferName = rightEyeColorBuffer;
-        s_renderBuffers.push_back(rb);
-        // "Bind" the newly created texture : all future texture
-        // functions will modify this texture glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, rightEyeColorBuffer);
+    //  Note that this texture format must be RGBA and unsigned byte, like
+    // the D3D11 path. If Unity's texture already is, RenderManager reads it
+    // directly; otherwise (or if it's an array slice, which RenderManager
+    // can't sample) we keep an RGBA8 copy and blit into it each frame.
+    GLuint colorBuffer = eyeCopy.source.name;
+    if (eyeCopy.source.internalFormat != GL_RGBA8 ||
+        eyeCopy.source.target != GL_TEXTURE_2D) {
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Unity eye "
+                                     "texture is not a plain RGBA8 texture, "
+                                     "will copy it each frame");
+        GLint previousRead = 0;
+        GLint previousDraw = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+
+        eyeCopy.target = CreateColorTextureOpenGL(eyeCopy.source.width,
+                                                  eyeCopy.source.height);
+
+        glGenFramebuffers(1, &eyeCopy.readFrameBuffer);
+        glGenFramebuffers(1, &eyeCopy.drawFrameBuffer);
+        OpenGLTextureInfo target;
+        target.name = eyeCopy.target;
+        eyeCopy.complete =
+            AttachTextureOpenGL(GL_READ_FRAMEBUFFER, eyeCopy.readFrameBuffer,
+                                eyeCopy.source) &&
+            AttachTextureOpenGL(GL_DRAW_FRAMEBUFFER, eyeCopy.drawFrameBuffer,
+                                target);
+        if (!eyeCopy.complete) {
+            PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Incomplete "
+                                       "framebuffer for eye copy");
+        }
 
-        // Give an empty image to OpenGL ( the last "0" means "empty" )
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
-                     static_cast<GLsizei>(s_renderInfo[eye].viewport.width),
-                     static_cast<GLsizei>(s_renderInfo[eye].viewport.height), 0,
-                     GL_RGB, GL_UNSIGNED_BYTE, &rightEyeColorBuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER,
+                          static_cast<GLuint>(previousRead));
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER,
+                          static_cast<GLuint>(previousDraw));
+        colorBuffer = eyeCopy.target;
     }
+    s_openGLEyeCopies.push_back(eyeCopy);
 
-    // Bilinear filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
+    osvr::renderkit::RenderBuffer rb;
+    rb.OpenGL = new osvr::renderkit::RenderBufferOpenGL;
+    rb.OpenGL->colorBufferName = colorBuffer;
+    s_renderBuffers.push_back(rb);
     return OSVR_RETURN_SUCCESS;
 }
 
 inline void CleanupBufferOpenGL(osvr::renderkit::RenderBuffer &rb) {
-    /// @todo incomplete cleanup - but better than leaking in case of failure.
+    if (rb.OpenGL != nullptr) {
+        for (auto &eyeCopy : s_openGLEyeCopies) {
+            if (eyeCopy.target != 0 &&
+                eyeCopy.target == rb.OpenGL->colorBufferName) {
+                glDeleteFramebuffers(1, &eyeCopy.readFrameBuffer);
+                glDeleteFramebuffers(1, &eyeCopy.drawFrameBuffer);
+                glDeleteTextures(1, &eyeCopy.target);
+                eyeCopy = OpenGLEyeCopy();
+            }
+        }
+    }
     delete rb.OpenGL;
     rb.OpenGL = nullptr;
 }
-#endif // SUPPORT_OPENGL
 
-#if SUPPORT_D3D11
-inline ID3D11Texture2D *GetEyeTextureD3D11(int eye) {
-    return reinterpret_cast<ID3D11Texture2D *>(eye == 0 ? s_leftEyeTexturePtr
-                                                        : s_rightEyeTexturePtr);
+/// Swap chain buffer @p index: a plugin-owned RGBA8 texture for eye
+/// index / s_requestedSwapChainLength, which Unity renders or copies into.
+inline OSVR_ReturnCode ConstructSwapChainBufferOpenGL(int index) {
+    if (!InitializeOpenGL()) {
+        return OSVR_RETURN_FAILURE;
+    }
+    const auto &viewport =
+        s_renderInfo[index / s_requestedSwapChainLength].viewport;
+
+    GLuint colorBuffer =
+        CreateColorTextureOpenGL(static_cast<GLsizei>(viewport.width),
+                                 static_cast<GLsizei>(viewport.height));
+
+    osvr::renderkit::RenderBuffer rb;
+    rb.OpenGL = new osvr::renderkit::RenderBufferOpenGL;
+    rb.OpenGL->colorBufferName = colorBuffer;
+    s_renderBuffers.push_back(rb);
+    return OSVR_RETURN_SUCCESS;
 }
 
-inline OSVR_ReturnCode ConstructBuffersD3D11(int eye) {
-    DebugLog("[OSVR Rendering Plugin] ConstructBuffersD3D11");
-    HRESULT hr;
-    // The color buffer for this eye.  We need to put this into
-    // a generic structure for the Present function, but we only need
+inline void CleanupSwapChainBufferOpenGL(osvr::renderkit::RenderBuffer &rb) {
+    if (rb.OpenGL != nullptr) {
+        glDeleteTextures(1, &rb.OpenGL->colorBufferName);
+    }
+    delete rb.OpenGL;
+    rb.OpenGL = nullptr;
+}
+
+inline void DeleteFoveatedEyeOpenGL(OpenGLFoveatedEye &eye) {
+    glDeleteFramebuffers(2, eye.regionFrameBuffers);
+    glDeleteTextures(2, eye.regionTextures);
+    glDeleteFramebuffers(1, &eye.eyeFrameBuffer);
+    glDeleteTextures(1, &eye.eyeTexture);
+    eye = OpenGLFoveatedEye();
+}
+
+/// A full-size eye buffer for RenderManager plus a texture per region for
+/// Unity, laid out as s_foveatedEyes[eye].
+inline OSVR_ReturnCode ConstructFoveatedBufferOpenGL(int eye) {
+    if (!InitializeOpenGL()) {
+        return OSVR_RETURN_FAILURE;
+    }
+    if (eye == 0) {
+        std::lock_guard<std::mutex> lock(s_foveationMutex);
+        s_openGLFoveatedEyes.clear();
+        s_foveatedEyes.clear();
+        s_foveatedBuffers = false;
+    }
+    const auto layout = ComputeFoveatedEye(s_renderInfo[eye]);
+    OpenGLFoveatedEye fov;
+    fov.eyeTexture =
+        CreateColorTextureOpenGL(static_cast<GLsizei>(layout.width),
+                                 static_cast<GLsizei>(layout.height));
+    fov.regionTextures[kOsvrFoveatedRegion_Periphery] =
+        CreateColorTextureOpenGL(static_cast<GLsizei>(layout.peripheryWidth),
+                                 static_cast<GLsizei>(layout.peripheryHeight));
+    fov.regionTextures[kOsvrFoveatedRegion_Center] =
+        CreateColorTextureOpenGL(static_cast<GLsizei>(layout.center.width),
+                                 static_cast<GLsizei>(layout.center.height));
+
+    GLint previousRead = 0;
+    GLint previousDraw = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+    glGenFramebuffers(1, &fov.eyeFrameBuffer);
+    glGenFramebuffers(2, fov.regionFrameBuffers);
+    OpenGLTextureInfo texture;
+    texture.name = fov.eyeTexture;
+    bool complete = AttachTextureOpenGL(GL_DRAW_FRAMEBUFFER,
+                                        fov.eyeFrameBuffer, texture);
+    for (int region = 0; region < 2; ++region) {
+        texture.name = fov.regionTextures[region];
+        complete = AttachTextureOpenGL(GL_READ_FRAMEBUFFER,
+                                       fov.regionFrameBuffers[region],
+                                       texture) &&
+                   complete;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousRead));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousDraw));
+    if (!complete) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Incomplete "
+                                   "framebuffer for foveated eye");
+        DeleteFoveatedEyeOpenGL(fov);
+        return OSVR_RETURN_FAILURE;
+    }
+    {
+        std::lock_guard<std::mutex> lock(s_foveationMutex);
+        s_foveatedEyes.push_back(layout);
+        s_openGLFoveatedEyes.push_back(fov);
+        s_foveatedBuffers = true;
+    }
+
+    osvr::renderkit::RenderBuffer rb;
+    rb.OpenGL = new osvr::renderkit::RenderBufferOpenGL;
+    rb.OpenGL->colorBufferName = fov.eyeTexture;
+    s_renderBuffers.push_back(rb);
+    return OSVR_RETURN_SUCCESS;
+}
+
+inline void CleanupFoveatedBufferOpenGL(osvr::renderkit::RenderBuffer &rb) {
+    if (rb.OpenGL != nullptr) {
+        std::lock_guard<std::mutex> lock(s_foveationMutex);
+        for (auto &fov : s_openGLFoveatedEyes) {
+            if (fov.eyeTexture == rb.OpenGL->colorBufferName) {
+                DeleteFoveatedEyeOpenGL(fov);
+            }
+        }
+    }
+    delete rb.OpenGL;
+    rb.OpenGL = nullptr;
+}
+
+/// Upscale the periphery into the eye buffer around the center region, then
+/// put the full-density center in the hole. Called with s_foveationMutex
+/// held.
+inline void StitchFoveatedEyeOpenGL(int eyeIndex) {
+    if (eyeIndex >= static_cast<int>(s_openGLFoveatedEyes.size()) ||
+        eyeIndex >= static_cast<int>(s_foveatedEyes.size())) {
+        return;
+    }
+    const auto &fov = s_openGLFoveatedEyes[eyeIndex];
+    const auto &layout = s_foveatedEyes[eyeIndex];
+
+    GLint previousRead = 0;
+    GLint previousDraw = 0;
+    GLint previousScissor[4] = {};
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+    glGetIntegerv(GL_SCISSOR_BOX, previousScissor);
+    const GLboolean previousScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+
+    // The periphery covers the whole eye, but only the strips below, above,
+    // left and right of the center are written from it: the scissor box
+    // clips the blit's writes, so nothing is stitched twice.
+    const auto w = static_cast<GLint>(layout.width);
+    const auto h = static_cast<GLint>(layout.height);
+    const auto &c = layout.center;
+    const auto left = static_cast<GLint>(c.left);
+    const auto lower = static_cast<GLint>(c.lower);
+    const auto right = static_cast<GLint>(c.left + c.width);
+    const auto upper = static_cast<GLint>(c.lower + c.height);
+    const GLint strips[4][4] = {{0, 0, w, lower},
+                                {0, upper, w, h - upper},
+                                {0, lower, left, upper - lower},
+                                {right, lower, w - right, upper - lower}};
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fov.eyeFrameBuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER,
+                      fov.regionFrameBuffers[kOsvrFoveatedRegion_Periphery]);
+    glEnable(GL_SCISSOR_TEST);
+    for (const auto &strip : strips) {
+        if (strip[2] <= 0 || strip[3] <= 0) {
+            continue;
+        }
+        glScissor(strip[0], strip[1], strip[2], strip[3]);
+        glBlitFramebuffer(0, 0, static_cast<GLint>(layout.peripheryWidth),
+                          static_cast<GLint>(layout.peripheryHeight), 0, 0, w,
+                          h, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    }
+    if (!previousScissorTest) {
+        glDisable(GL_SCISSOR_TEST);
+    }
+    glScissor(previousScissor[0], previousScissor[1], previousScissor[2],
+              previousScissor[3]);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER,
+                      fov.regionFrameBuffers[kOsvrFoveatedRegion_Center]);
+    glBlitFramebuffer(0, 0, static_cast<GLint>(c.width),
+                      static_cast<GLint>(c.height),
+                      static_cast<GLint>(c.left), static_cast<GLint>(c.lower),
+                      static_cast<GLint>(c.left + c.width),
+                      static_cast<GLint>(c.lower + c.height),
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousRead));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousDraw));
+}
+#endif // SUPPORT_OPENGL
+
+#if SUPPORT_D3D11
+inline ID3D11Texture2D *GetEyeTextureD3D11(int eye) {
+    return reinterpret_cast<ID3D11Texture2D *>(eye == 0 ? s_leftEyeTexturePtr
+                                                        : s_rightEyeTexturePtr);
+}
+
+inline OSVR_ReturnCode ConstructBuffersD3D11(int eye) {
+    PluginLog<LogLevel::Debug>("[OSVR Rendering Plugin] ConstructBuffersD3D11");
+    HRESULT hr;
+    // The color buffer for this eye.  We need to put this into
+    // a generic structure for the Present function, but we only need
     // to fill in the Direct3D portion.
     //  Note that this texture format must be RGBA and unsigned byte,
     // so that we can present it to Direct3D for DirectMode.
@@ -597,6 +1738,11 @@ inline OSVR_ReturnCode ConstructBuffersD3D11(int eye) {
     unsigned height = static_cast<unsigned>(s_renderInfo[eye].viewport.height);
 
     D3DTexture->GetDesc(&s_textureDesc);
+    auto device = s_renderInfo[eye].library.D3D11->device;
+
+    if (eye == 0) {
+        s_eyeCopiesD3D11.clear();
+    }
 
     // Fill in the resource view for your render texture buffer here
     D3D11_RENDER_TARGET_VIEW_DESC renderTargetViewDesc = {};
@@ -607,24 +1753,49 @@ inline OSVR_ReturnCode ConstructBuffersD3D11(int eye) {
     /// and not only do you not get direct mode, you get multicolored static on
     /// the display.
     renderTargetViewDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    // The registered texture is always plain 2D: a texture array slice is
+    // registered through its copy.
     renderTargetViewDesc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
     renderTargetViewDesc.Texture2D.MipSlice = 0;
 
-    // Create the render target view.
+    ID3D11Texture2D *eyeCopy = nullptr;
+    if (s_eyeBufferLayout == kOsvrEyeBufferLayout_TextureArray) {
+        D3D11_TEXTURE2D_DESC copyDesc = s_textureDesc;
+        copyDesc.MipLevels = 1;
+        copyDesc.ArraySize = 1;
+        copyDesc.Usage = D3D11_USAGE_DEFAULT;
+        copyDesc.BindFlags =
+            D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        copyDesc.CPUAccessFlags = 0;
+        copyDesc.MiscFlags = 0;
+        hr = device->CreateTexture2D(&copyDesc, nullptr, &eyeCopy);
+        if (FAILED(hr)) {
+            PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not "
+                                       "create copy texture for eye");
+            return OSVR_RETURN_FAILURE;
+        }
+    }
+    ID3D11Texture2D *colorBuffer = eyeCopy != nullptr ? eyeCopy : D3DTexture;
+
+    // Create the render target view, of the texture RenderManager reads.
     ID3D11RenderTargetView *renderTargetView =
         nullptr; //< Pointer to our render target view
-    hr = s_renderInfo[eye].library.D3D11->device->CreateRenderTargetView(
-        D3DTexture, &renderTargetViewDesc, &renderTargetView);
+    hr = device->CreateRenderTargetView(colorBuffer, &renderTargetViewDesc,
+                                        &renderTargetView);
     if (FAILED(hr)) {
-        DebugLog(
-            "[OSVR Rendering Plugin] Could not create render target for eye");
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not create "
+                                   "render target for eye");
+        if (eyeCopy != nullptr) {
+            eyeCopy->Release();
+        }
         return OSVR_RETURN_FAILURE;
     }
+    s_eyeCopiesD3D11.push_back(eyeCopy);
 
     // Push the filled-in RenderBuffer onto the stack.
     std::unique_ptr<osvr::renderkit::RenderBufferD3D11> rbD3D(
         new osvr::renderkit::RenderBufferD3D11);
-    rbD3D->colorBuffer = D3DTexture;
+    rbD3D->colorBuffer = colorBuffer;
     rbD3D->colorBufferView = renderTargetView;
     osvr::renderkit::RenderBuffer rb;
     rb.D3D11 = rbD3D.get();
@@ -637,38 +1808,316 @@ inline OSVR_ReturnCode ConstructBuffersD3D11(int eye) {
 }
 
 inline void CleanupBufferD3D11(osvr::renderkit::RenderBuffer &rb) {
+    if (rb.D3D11 != nullptr) {
+        rb.D3D11->colorBufferView->Release();
+        for (auto &eyeCopy : s_eyeCopiesD3D11) {
+            if (eyeCopy != nullptr && eyeCopy == rb.D3D11->colorBuffer) {
+                eyeCopy->Release();
+                eyeCopy = nullptr;
+            }
+        }
+    }
     delete rb.D3D11;
     rb.D3D11 = nullptr;
 }
+
+/// Swap chain buffer @p index: a plugin-owned RGBA8 texture, and its render
+/// target view, for eye index / s_requestedSwapChainLength.
+inline OSVR_ReturnCode ConstructSwapChainBufferD3D11(int index) {
+    if (index == 0) {
+        // Unity renders straight into our buffers; nothing to copy.
+        s_eyeCopiesD3D11.clear();
+    }
+    const auto &ri = s_renderInfo[index / s_requestedSwapChainLength];
+    auto device = ri.library.D3D11->device;
+
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    textureDesc.Width = static_cast<UINT>(ri.viewport.width);
+    textureDesc.Height = static_cast<UINT>(ri.viewport.height);
+    textureDesc.MipLevels = 1;
+    textureDesc.ArraySize = 1;
+    textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.SampleDesc.Quality = 0;
+    textureDesc.Usage = D3D11_USAGE_DEFAULT;
+    textureDesc.BindFlags =
+        D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+    ID3D11Texture2D *texture = nullptr;
+    if (FAILED(device->CreateTexture2D(&textureDesc, nullptr, &texture))) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not create "
+                                   "swap chain texture");
+        return OSVR_RETURN_FAILURE;
+    }
+
+    D3D11_RENDER_TARGET_VIEW_DESC renderTargetViewDesc = {};
+    renderTargetViewDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    renderTargetViewDesc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+    renderTargetViewDesc.Texture2D.MipSlice = 0;
+    ID3D11RenderTargetView *renderTargetView = nullptr;
+    if (FAILED(device->CreateRenderTargetView(texture, &renderTargetViewDesc,
+                                              &renderTargetView))) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not create "
+                                   "render target for swap chain texture");
+        texture->Release();
+        return OSVR_RETURN_FAILURE;
+    }
+
+    osvr::renderkit::RenderBuffer rb;
+    rb.D3D11 = new osvr::renderkit::RenderBufferD3D11;
+    rb.D3D11->colorBuffer = texture;
+    rb.D3D11->colorBufferView = renderTargetView;
+    s_renderBuffers.push_back(rb);
+    return OSVR_RETURN_SUCCESS;
+}
+
+inline void CleanupSwapChainBufferD3D11(osvr::renderkit::RenderBuffer &rb) {
+    if (rb.D3D11 != nullptr) {
+        rb.D3D11->colorBufferView->Release();
+        rb.D3D11->colorBuffer->Release();
+    }
+    delete rb.D3D11;
+    rb.D3D11 = nullptr;
+}
+
+inline void ReleaseSharedEyeCopyD3D11(SharedEyeCopyD3D11 &copy) {
+    for (IUnknown *p : {static_cast<IUnknown *>(copy.presentMutex),
+                        static_cast<IUnknown *>(copy.presentTexture),
+                        static_cast<IUnknown *>(copy.mutex),
+                        static_cast<IUnknown *>(copy.texture)}) {
+        if (p != nullptr) {
+            p->Release();
+        }
+    }
+    copy = SharedEyeCopyD3D11();
+}
+
+/// A copy of Unity's texture for @p eye, created on Unity's device and opened
+/// on RenderManager's, with a render target view there for RenderManager.
+inline OSVR_ReturnCode ConstructSharedEyeCopyD3D11(int eye) {
+    GetEyeTextureD3D11(eye)->GetDesc(&s_textureDesc);
+    D3D11_TEXTURE2D_DESC copyDesc = s_textureDesc;
+    copyDesc.MipLevels = 1;
+    copyDesc.ArraySize = 1;
+    copyDesc.Usage = D3D11_USAGE_DEFAULT;
+    copyDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+    copyDesc.CPUAccessFlags = 0;
+    copyDesc.MiscFlags = D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX;
+
+    SharedEyeCopyD3D11 copy;
+    auto releaseCopy =
+        osvr::util::finally([&] { ReleaseSharedEyeCopyD3D11(copy); });
+    if (FAILED(s_library.D3D11->device->CreateTexture2D(&copyDesc, nullptr,
+                                                        &copy.texture))) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not create "
+                                   "shared copy texture for eye");
+        return OSVR_RETURN_FAILURE;
+    }
+    IDXGIResource *resource = nullptr;
+    HANDLE sharedHandle = nullptr;
+    if (SUCCEEDED(copy.texture->QueryInterface(
+            __uuidof(IDXGIResource), reinterpret_cast<void **>(&resource)))) {
+        if (FAILED(resource->GetSharedHandle(&sharedHandle))) {
+            sharedHandle = nullptr;
+        }
+        resource->Release();
+    }
+    auto presentDevice = s_presentLibrary.D3D11->device;
+    if (sharedHandle == nullptr ||
+        FAILED(copy.texture->QueryInterface(
+            __uuidof(IDXGIKeyedMutex),
+            reinterpret_cast<void **>(&copy.mutex))) ||
+        FAILED(presentDevice->OpenSharedResource(
+            sharedHandle, __uuidof(ID3D11Texture2D),
+            reinterpret_cast<void **>(&copy.presentTexture))) ||
+        FAILED(copy.presentTexture->QueryInterface(
+            __uuidof(IDXGIKeyedMutex),
+            reinterpret_cast<void **>(&copy.presentMutex)))) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not share "
+                                   "eye copy with RenderManager's device");
+        return OSVR_RETURN_FAILURE;
+    }
+
+    D3D11_RENDER_TARGET_VIEW_DESC renderTargetViewDesc = {};
+    renderTargetViewDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    renderTargetViewDesc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+    renderTargetViewDesc.Texture2D.MipSlice = 0;
+    ID3D11RenderTargetView *renderTargetView = nullptr;
+    if (FAILED(presentDevice->CreateRenderTargetView(copy.presentTexture,
+                                                     &renderTargetViewDesc,
+                                                     &renderTargetView))) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not create "
+                                   "render target for shared eye copy");
+        return OSVR_RETURN_FAILURE;
+    }
+
+    osvr::renderkit::RenderBuffer rb;
+    rb.D3D11 = new osvr::renderkit::RenderBufferD3D11;
+    rb.D3D11->colorBuffer = copy.presentTexture;
+    rb.D3D11->colorBufferView = renderTargetView;
+    s_renderBuffers.push_back(rb);
+    s_sharedEyeCopiesD3D11.push_back(copy);
+    releaseCopy.cancel();
+    return OSVR_RETURN_SUCCESS;
+}
+
+inline void CleanupSharedEyeCopyD3D11(osvr::renderkit::RenderBuffer &rb) {
+    if (rb.D3D11 != nullptr) {
+        rb.D3D11->colorBufferView->Release();
+        for (auto &copy : s_sharedEyeCopiesD3D11) {
+            if (copy.presentTexture == rb.D3D11->colorBuffer) {
+                ReleaseSharedEyeCopyD3D11(copy);
+            }
+        }
+    }
+    delete rb.D3D11;
+    rb.D3D11 = nullptr;
+}
+
+/// Shared copies of each of @p eyes eyes, one set per frame in flight or per
+/// timewarp slot, in place of Unity's textures: with RenderManager on its own
+/// device, it can only read textures shared with it.
+inline OSVR_ReturnCode ConstructSharedEyeCopiesD3D11(int eyes) {
+    const int requested =
+        s_asyncTimewarpRequested.load(std::memory_order_relaxed)
+            ? static_cast<int>(AsyncTimewarp::Slots)
+            : s_requestedFramesInFlight.load(std::memory_order_relaxed);
+    const int sets = requested > 1 ? requested : 1;
+    const auto ret = applyRenderBufferConstructor(
+        eyes * sets,
+        [sets](int index) { return ConstructSharedEyeCopyD3D11(index / sets); },
+        CleanupSharedEyeCopyD3D11);
+    if (ret == OSVR_RETURN_SUCCESS) {
+        s_eyeCopySets = sets;
+    }
+    return ret;
+}
 #endif // SUPPORT_D3D11
 
+/// Builds s_requestedSwapChainLength plugin-owned buffers for each of the
+/// @p eyes eyes, in place of Unity's textures.
+inline OSVR_ReturnCode ConstructSwapChain(int eyes) {
+    if (eyes > static_cast<int>(RenderInfoSnapshot::MaxEyes)) {
+        return OSVR_RETURN_FAILURE;
+    }
+    const int length = s_requestedSwapChainLength;
+    const auto ret = s_backend.load()->constructSwapChain(eyes * length);
+    if (ret == OSVR_RETURN_SUCCESS) {
+        // The first AcquireEyeBuffer returns buffer 0.
+        for (auto &acquired : s_acquiredEyeBuffer) {
+            acquired.store(length - 1, std::memory_order_relaxed);
+        }
+        ClearEyeBufferHolds();
+        s_swapChainLength = length;
+    }
+    return ret;
+}
+
+/// Builds foveated eye buffers for each of the @p eyes eyes, in place of
+/// Unity's textures.
+inline OSVR_ReturnCode ConstructFoveatedBuffers(int eyes) {
+    const auto ret = s_backend.load()->constructFoveatedBuffers(eyes);
+    if (ret != OSVR_RETURN_SUCCESS) {
+        std::lock_guard<std::mutex> lock(s_foveationMutex);
+        s_foveatedEyes.clear();
+        s_foveatedBuffers = false;
+    }
+    return ret;
+}
+
 OSVR_ReturnCode UNITY_INTERFACE_API ConstructRenderBuffers() {
     if (!s_deviceType) {
-        DebugLog("Device type not supported.");
+        PluginLog<LogLevel::Error>("Device type not supported.");
+        return OSVR_RETURN_FAILURE;
+    }
+    if (!RenderManagerReady()) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] "
+                                   "ConstructRenderBuffers called before "
+                                   "RenderManager was ready.");
+        return OSVR_RETURN_FAILURE;
+    }
+    // Held until the new buffers are complete.
+    PresentThreadsPause pause;
+    if (!pause.stopped()) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] "
+                                   "ConstructRenderBuffers: the render thread "
+                                   "did not stop the present thread, so the "
+                                   "buffers it uses were kept. Try again "
+                                   "once render events are being issued.");
         return OSVR_RETURN_FAILURE;
     }
     UpdateRenderInfo();
 
     // construct buffers
     const int n = static_cast<int>(s_renderInfo.size());
-    switch (s_deviceType.getDeviceTypeEnum()) {
+
+    s_croppingViewports.clear();
+    s_swapChainLength = 0;
+    if (s_foveationCenterFraction > 0) {
+        return ConstructFoveatedBuffers(n);
+    }
+    bool swapChain = s_requestedSwapChainLength > 0;
 #if SUPPORT_D3D11
-    case OSVRSupportedRenderers::D3D11:
-        return applyRenderBufferConstructor(n, ConstructBuffersD3D11,
-                                            CleanupBufferD3D11);
-        break;
-#endif
-#if SUPPORT_OPENGL
-    case OSVRSupportedRenderers::OpenGL:
-        return applyRenderBufferConstructor(n, ConstructBuffersOpenGL,
-                                            CleanupBufferOpenGL);
-        break;
-#endif
-    case OSVRSupportedRenderers::EmptyRenderer:
-    default:
-        DebugLog("Device type not supported.");
+    if (swapChain && s_separatePresentDeviceD3D11) {
+        // Unity can't render into textures on RenderManager's device.
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Eye buffer "
+                                     "swap chains are not supported with "
+                                     "asynchronous present on Direct3D 11, "
+                                     "using Unity's textures");
+        swapChain = false;
+    }
+#endif // SUPPORT_D3D11
+    if (swapChain) {
+        return ConstructSwapChain(n);
+    }
+
+    // Side-by-side: every eye's buffer is the whole double-wide texture, so
+    // tell RenderManager which horizontal strip belongs to each eye.
+    if (s_eyeBufferLayout == kOsvrEyeBufferLayout_SideBySide) {
+        for (int i = 0; i < n; ++i) {
+            osvr::renderkit::OSVR_ViewportDescription strip;
+            strip.left = static_cast<double>(i) / n;
+            strip.lower = 0;
+            strip.width = 1.0 / n;
+            strip.height = 1;
+            s_croppingViewports.push_back(strip);
+        }
+    }
+
+    return s_backend.load()->constructBuffers(n);
+}
+
+void UNITY_INTERFACE_API ConfigureStandInRenderBackend(
+    int eyeCount, double vsyncIntervalSeconds, double trackerLatencySeconds) {
+    if (eyeCount <= 0) {
+        useRenderManagerBackend();
+        return;
+    }
+    StandInRenderBackendConfig config;
+    config.eyeCount = static_cast<std::size_t>(eyeCount);
+    config.vsyncIntervalSeconds = vsyncIntervalSeconds;
+    config.trackerLatencySeconds = trackerLatencySeconds;
+    useStandInRenderBackend(config);
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API
+ConfigureTraceReplayBackend(const char *tracePath, int paced) {
+    if (tracePath == nullptr || *tracePath == '\0') {
+        useRenderManagerBackend();
+        return OSVR_RETURN_SUCCESS;
+    }
+    auto trace = std::make_shared<PoseTraceReader>();
+    if (!trace->load(tracePath)) {
+        std::string message = "[OSVR Rendering Plugin] Could not load pose "
+                              "trace for replay: ";
+        message += trace->error();
+        PluginLog<LogLevel::Error>(message.c_str());
         return OSVR_RETURN_FAILURE;
     }
+    TraceReplayBackendConfig config;
+    config.trace = trace;
+    config.paced = paced != 0;
+    useTraceReplayBackend(config);
+    return OSVR_RETURN_SUCCESS;
 }
 
 void UNITY_INTERFACE_API SetNearClipDistance(double distance) {
@@ -686,21 +2135,316 @@ void UNITY_INTERFACE_API SetIPD(double ipdMeters) {
     s_renderParams.IPDMeters = s_ipd;
 }
 
+/// Copies one eye out of the latest snapshot; value-initialized if there is
+/// no render info for that eye yet.
+inline osvr::renderkit::RenderInfo GetLastRenderInfo(int eye) {
+    osvr::renderkit::RenderInfo ri = {};
+    s_lastRenderInfo.readEye(static_cast<std::size_t>(eye), ri);
+    return ri;
+}
+
 osvr::renderkit::OSVR_ViewportDescription UNITY_INTERFACE_API
 GetViewport(int eye) {
-	std::lock_guard<std::mutex> lock(m_mutex);
-	return s_lastRenderInfo[eye].viewport;
+    return GetLastRenderInfo(eye).viewport;
 }
 
 osvr::renderkit::OSVR_ProjectionMatrix UNITY_INTERFACE_API
 GetProjectionMatrix(int eye) {
-	std::lock_guard<std::mutex> lock(m_mutex);
-	return s_lastRenderInfo[eye].projection;
+    return GetLastRenderInfo(eye).projection;
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API SetFixedFoveation(double centerFraction,
+                                                      double peripheryScale) {
+    if (centerFraction <= 0 || centerFraction >= 1) {
+        s_foveationCenterFraction = 0;
+        s_foveationPeripheryScale = 1;
+        return OSVR_RETURN_SUCCESS;
+    }
+    if (peripheryScale <= 0 || peripheryScale > 1) {
+        return OSVR_RETURN_FAILURE;
+    }
+#if SUPPORT_OPENGL
+    const bool supported =
+        !s_deviceType ||
+        s_deviceType.getDeviceTypeEnum() == OSVRSupportedRenderers::OpenGL;
+#else
+    const bool supported = false;
+#endif
+    if (!supported) {
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Fixed foveation "
+                                     "is only supported on OpenGL.");
+        return OSVR_RETURN_FAILURE;
+    }
+    s_foveationCenterFraction = centerFraction;
+    s_foveationPeripheryScale = peripheryScale;
+    return OSVR_RETURN_SUCCESS;
+}
+
+osvr::renderkit::OSVR_ProjectionMatrix UNITY_INTERFACE_API
+GetFoveatedRegionProjectionMatrix(int eye, int region) {
+    auto projection = GetProjectionMatrix(eye);
+    FoveatedEye layout;
+    {
+        std::lock_guard<std::mutex> lock(s_foveationMutex);
+        if (eye < 0 || eye >= static_cast<int>(s_foveatedEyes.size()) ||
+            region != kOsvrFoveatedRegion_Center) {
+            return projection;
+        }
+        layout = s_foveatedEyes[eye];
+    }
+    // The center's frustum is the matching slice of the eye's.
+    const auto &c = layout.center;
+    const double w = projection.right - projection.left;
+    const double h = projection.top - projection.bottom;
+    const double left = projection.left;
+    const double bottom = projection.bottom;
+    projection.left = left + w * c.left / layout.width;
+    projection.right = left + w * (c.left + c.width) / layout.width;
+    projection.bottom = bottom + h * c.lower / layout.height;
+    projection.top = bottom + h * (c.lower + c.height) / layout.height;
+    return projection;
+}
+
+osvr::renderkit::OSVR_ViewportDescription UNITY_INTERFACE_API
+GetFoveatedRegionViewport(int eye, int region) {
+    osvr::renderkit::OSVR_ViewportDescription viewport = {};
+    std::lock_guard<std::mutex> lock(s_foveationMutex);
+    if (eye < 0 || eye >= static_cast<int>(s_foveatedEyes.size())) {
+        return viewport;
+    }
+    const auto &layout = s_foveatedEyes[eye];
+    if (region == kOsvrFoveatedRegion_Center) {
+        viewport.width = layout.center.width;
+        viewport.height = layout.center.height;
+    } else if (region == kOsvrFoveatedRegion_Periphery) {
+        viewport.width = layout.peripheryWidth;
+        viewport.height = layout.peripheryHeight;
+    }
+    return viewport;
+}
+
+osvr::renderkit::OSVR_ViewportDescription UNITY_INTERFACE_API
+GetFoveatedPeripheryMask(int eye) {
+    osvr::renderkit::OSVR_ViewportDescription mask = {};
+    std::lock_guard<std::mutex> lock(s_foveationMutex);
+    if (eye < 0 || eye >= static_cast<int>(s_foveatedEyes.size())) {
+        return mask;
+    }
+    const auto &layout = s_foveatedEyes[eye];
+    if (layout.width <= 0 || layout.height <= 0) {
+        return mask;
+    }
+    // The center in periphery pixels, shrunk by the texels the linear
+    // upscale of the strips around it may still sample.
+    const double margin = 2;
+    const auto sx = layout.peripheryWidth / layout.width;
+    const auto sy = layout.peripheryHeight / layout.height;
+    const auto &c = layout.center;
+    mask.left = std::floor(c.left * sx) + margin;
+    mask.lower = std::floor(c.lower * sy) + margin;
+    mask.width = std::max(
+        0.0, std::ceil((c.left + c.width) * sx) - margin - mask.left);
+    mask.height = std::max(
+        0.0, std::ceil((c.lower + c.height) * sy) - margin - mask.lower);
+    return mask;
+}
+
+/// Whether the latest render info's viewports are the ones the hidden area
+/// meshes were last checked against; if not, remembers them. Call with
+/// s_hiddenAreaMeshMutex held.
+static bool HiddenAreaMeshViewportsUnchanged() {
+    bool unchanged = true;
+    s_lastRenderInfo.readAll(
+        [&](const osvr::renderkit::RenderInfo *eyes, std::size_t n) {
+            unchanged = n == s_hiddenAreaMeshViewportCount;
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto &viewport = eyes[i].viewport;
+                auto &checked = s_hiddenAreaMeshViewports[i];
+                if (unchanged &&
+                    (viewport.left != checked.left ||
+                     viewport.lower != checked.lower ||
+                     viewport.width != checked.width ||
+                     viewport.height != checked.height)) {
+                    unchanged = false;
+                }
+                checked = viewport;
+            }
+            s_hiddenAreaMeshViewportCount = n;
+        });
+    return unchanged;
+}
+
+/// Make s_hiddenAreaMeshes current for s_clientContext's display. Call with
+/// s_hiddenAreaMeshMutex held.
+static bool UpdateHiddenAreaMeshes() {
+    if (s_clientContext == nullptr) {
+        return false;
+    }
+    // Always check the viewports, so they are current for the next call.
+    const bool viewportsUnchanged = HiddenAreaMeshViewportsUnchanged();
+    if (s_hiddenAreaMeshContext == s_clientContext && viewportsUnchanged) {
+        return !s_hiddenAreaMeshes.empty();
+    }
+    // Until the descriptor is read, every call tries again: it may not have
+    // arrived from the server yet.
+    s_hiddenAreaMeshContext = nullptr;
+    std::size_t length = 0;
+    if (osvrClientGetStringParameterLength(s_clientContext, "/display",
+                                           &length) != OSVR_RETURN_SUCCESS ||
+        length == 0) {
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] No display "
+                                     "descriptor for the hidden area mesh.");
+        s_hiddenAreaMeshes.clear();
+        s_hiddenAreaMeshDistortions.clear();
+        return false;
+    }
+    // Reuses the last descriptor's storage.
+    s_hiddenAreaMeshDescriptor.resize(length);
+    if (osvrClientGetStringParameter(s_clientContext, "/display",
+                                     &s_hiddenAreaMeshDescriptor[0],
+                                     length) != OSVR_RETURN_SUCCESS) {
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Could not read "
+                                     "the display descriptor.");
+        return !s_hiddenAreaMeshes.empty();
+    }
+    // Drop the terminator the length counts.
+    s_hiddenAreaMeshDescriptor.resize(
+        std::strlen(s_hiddenAreaMeshDescriptor.c_str()));
+    s_hiddenAreaMeshContext = s_clientContext;
+    std::vector<LensDistortion> eyes;
+    std::string error;
+    if (!ParseLensDistortion(s_hiddenAreaMeshDescriptor, eyes, error)) {
+        std::string message = "[OSVR Rendering Plugin] No hidden area mesh "
+                              "for this display: ";
+        message += error;
+        PluginLog<LogLevel::Warning>(message.c_str());
+        s_hiddenAreaMeshes.clear();
+        s_hiddenAreaMeshDistortions.clear();
+        return false;
+    }
+    if (eyes == s_hiddenAreaMeshDistortions && !s_hiddenAreaMeshes.empty()) {
+        return true;
+    }
+    s_hiddenAreaMeshes.clear();
+    for (const auto &eye : eyes) {
+        s_hiddenAreaMeshes.push_back(BuildHiddenAreaMesh(eye));
+    }
+    s_hiddenAreaMeshDistortions = std::move(eyes);
+    PluginLog<LogLevel::Debug>("[OSVR Rendering Plugin] Built hidden area "
+                               "meshes.");
+    return true;
+}
+
+int UNITY_INTERFACE_API GetHiddenAreaMesh(int eye, int type, float *vertices,
+                                          int maxVertices) {
+    std::lock_guard<std::mutex> lock(s_hiddenAreaMeshMutex);
+    if (!UpdateHiddenAreaMeshes() || eye < 0 ||
+        eye >= static_cast<int>(s_hiddenAreaMeshes.size()) ||
+        (type != kOsvrHiddenAreaMesh_Hidden &&
+         type != kOsvrHiddenAreaMesh_Visible)) {
+        return -1;
+    }
+    const auto &mesh = s_hiddenAreaMeshes[eye];
+    const auto &triangles =
+        type == kOsvrHiddenAreaMesh_Hidden ? mesh.hidden : mesh.visible;
+    const int vertexCount = static_cast<int>(triangles.size() / 2);
+    if (vertices != nullptr && maxVertices > 0) {
+        std::copy_n(triangles.data(), 2 * std::min(vertexCount, maxVertices),
+                    vertices);
+    }
+    return vertexCount;
 }
 
 OSVR_Pose3 UNITY_INTERFACE_API GetEyePose(int eye) {
-	std::lock_guard<std::mutex> lock(m_mutex);
-	return s_lastRenderInfo[eye].pose;
+    return GetLastRenderInfo(eye).pose;
+}
+
+static_assert(OSVR_FRAME_STATE_MAX_EYES == RenderInfoSnapshot::MaxEyes,
+              "GetFrameState must be able to hold every snapshotted eye");
+
+OSVR_ReturnCode UNITY_INTERFACE_API GetFrameState(OSVR_FrameState *state) {
+    if (state == nullptr) {
+        return OSVR_RETURN_FAILURE;
+    }
+    state->eyeCount = 0;
+    const auto generation = s_lastRenderInfo.readAll(
+        [&](const osvr::renderkit::RenderInfo *eyes, std::size_t n) {
+            state->eyeCount = static_cast<int32_t>(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                state->eyes[i].pose = eyes[i].pose;
+                state->eyes[i].projection = eyes[i].projection;
+                state->eyes[i].viewport = eyes[i].viewport;
+            }
+        });
+    state->sequence = generation;
+    state->reserved = 0;
+    return generation == 0 ? OSVR_RETURN_FAILURE : OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API
+GetFrameMatrices(OSVR_FrameMatrices *matrices, int flipY) {
+    if (matrices == nullptr) {
+        return OSVR_RETURN_FAILURE;
+    }
+    OSVR_PoseState poses[OSVR_FRAME_STATE_MAX_EYES];
+    osvr::renderkit::OSVR_ProjectionMatrix
+        projections[OSVR_FRAME_STATE_MAX_EYES];
+    std::size_t eyeCount = 0;
+    const auto generation = s_lastRenderInfo.readAll(
+        [&](const osvr::renderkit::RenderInfo *eyes, std::size_t n) {
+            eyeCount = n;
+            for (std::size_t i = 0; i < n; ++i) {
+                poses[i] = eyes[i].pose;
+                projections[i] = eyes[i].projection;
+            }
+        });
+    // Convert outside the snapshot read, to keep it short.
+    ComputeUnityEyeMatrices(poses, projections, eyeCount, flipY != 0,
+                            matrices->eyes);
+    matrices->sequence = generation;
+    matrices->eyeCount = static_cast<int32_t>(eyeCount);
+    matrices->reserved = 0;
+    return generation == 0 ? OSVR_RETURN_FAILURE : OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API
+GetCombinedCullingFrustum(OSVR_CullingFrustum *frustum,
+                          int measureExtraVolume) {
+    if (frustum == nullptr) {
+        return OSVR_RETURN_FAILURE;
+    }
+    OSVR_PoseState poses[OSVR_FRAME_STATE_MAX_EYES];
+    osvr::renderkit::OSVR_ProjectionMatrix
+        projections[OSVR_FRAME_STATE_MAX_EYES];
+    std::size_t eyeCount = 0;
+    const auto generation = s_lastRenderInfo.readAll(
+        [&](const osvr::renderkit::RenderInfo *eyes, std::size_t n) {
+            eyeCount = n;
+            for (std::size_t i = 0; i < n; ++i) {
+                poses[i] = eyes[i].pose;
+                projections[i] = eyes[i].projection;
+            }
+        });
+    // The eye poses already carry the IPD from SetIPD, through
+    // s_renderParams.
+    CombinedFrustum combined;
+    if (generation == 0 ||
+        !ComputeCombinedFrustum(poses, projections, eyeCount,
+                                measureExtraVolume != 0, combined)) {
+        return OSVR_RETURN_FAILURE;
+    }
+    ComputeUnityEyeMatrices(&combined.pose, &combined.projection, 1, false,
+                            &frustum->matrices);
+    frustum->sequence = generation;
+    frustum->extraVolume = -1;
+    frustum->extraVolumeFraction = -1;
+    if (combined.eyeVolume > 0) {
+        const double extra = combined.volume - combined.eyeVolume;
+        frustum->extraVolume = static_cast<float>(extra);
+        frustum->extraVolumeFraction =
+            static_cast<float>(extra / combined.eyeVolume);
+    }
+    return OSVR_RETURN_SUCCESS;
 }
 
 // --------------------------------------------------------------------------
@@ -721,16 +2465,99 @@ int UNITY_INTERFACE_API SetColorBufferFromUnity(void *texturePtr, int eye) {
         return OSVR_RETURN_FAILURE;
     }
 
-    DebugLog("[OSVR Rendering Plugin] SetColorBufferFromUnity");
+    PluginLog<LogLevel::Debug>("[OSVR Rendering Plugin] "
+                               "SetColorBufferFromUnity");
+    s_eyeBufferLayout = kOsvrEyeBufferLayout_Separate;
     if (eye == 0) {
         s_leftEyeTexturePtr = texturePtr;
     } else {
         s_rightEyeTexturePtr = texturePtr;
     }
+    s_backend.load()->recordEyeTexture(eye, texturePtr);
+
+    return OSVR_RETURN_SUCCESS;
+}
+void UNITY_INTERFACE_API SetEyeBufferCount(int count) {
+    s_requestedSwapChainLength =
+        std::min(std::max(count, 0), MaxSwapChainLength);
+}
+
+int UNITY_INTERFACE_API AcquireEyeBuffer(int eye) {
+    const int length = s_swapChainLength;
+    if (length <= 0 || eye < 0 ||
+        eye >= static_cast<int>(RenderInfoSnapshot::MaxEyes)) {
+        return -1;
+    }
+    // The next buffer round that is neither locked in nor presenting; the
+    // one already acquired only if nothing else is free.
+    const int acquired =
+        s_acquiredEyeBuffer[eye].load(std::memory_order_relaxed);
+    for (int step = 1; step <= length; ++step) {
+        const int index = (acquired + step) % length;
+        if (s_eyeBufferHolds[eye][index].load(std::memory_order_acquire) ==
+            0) {
+            s_acquiredEyeBuffer[eye].store(index, std::memory_order_release);
+            return index;
+        }
+    }
+    return -1;
+}
+
+void *UNITY_INTERFACE_API GetEyeBufferTexture(int eye, int index) {
+    const int length = s_swapChainLength;
+    const auto buffer = static_cast<std::size_t>(eye * length + index);
+    if (!s_deviceType || length <= 0 || eye < 0 || index < 0 ||
+        index >= length || buffer >= s_renderBuffers.size()) {
+        return nullptr;
+    }
+    return s_backend.load()->nativeTexture(s_renderBuffers[buffer]);
+}
+
+void *UNITY_INTERFACE_API GetFoveatedRegionTexture(int eye, int region) {
+    if (region != kOsvrFoveatedRegion_Periphery &&
+        region != kOsvrFoveatedRegion_Center) {
+        return nullptr;
+    }
+#if SUPPORT_OPENGL
+    std::lock_guard<std::mutex> lock(s_foveationMutex);
+    if (!s_foveatedEyes.empty() && eye >= 0 &&
+        eye < static_cast<int>(s_openGLFoveatedEyes.size())) {
+        return reinterpret_cast<void *>(static_cast<std::uintptr_t>(
+            s_openGLFoveatedEyes[eye].regionTextures[region]));
+    }
+#endif
+    return nullptr;
+}
+
+int UNITY_INTERFACE_API SetStereoColorBufferFromUnity(void *texturePtr,
+                                                      int layout) {
+    if (!s_deviceType || (layout != kOsvrEyeBufferLayout_SideBySide &&
+                          layout != kOsvrEyeBufferLayout_TextureArray)) {
+        return OSVR_RETURN_FAILURE;
+    }
+
+    PluginLog<LogLevel::Debug>("[OSVR Rendering Plugin] "
+                               "SetStereoColorBufferFromUnity");
+    s_eyeBufferLayout = static_cast<EyeBufferLayouts>(layout);
+    s_leftEyeTexturePtr = texturePtr;
+    s_rightEyeTexturePtr = texturePtr;
+    const auto backend = s_backend.load();
+    backend->recordEyeTexture(0, texturePtr);
+    backend->recordEyeTexture(1, texturePtr);
 
     return OSVR_RETURN_SUCCESS;
 }
+
 #if SUPPORT_D3D11
+/// The subresource of Unity's texture holding @p eyeIndex: its array slice,
+/// or the top mip of the only slice.
+inline UINT EyeSubresourceD3D11(int eyeIndex) {
+    const UINT slice = s_eyeBufferLayout == kOsvrEyeBufferLayout_TextureArray
+                           ? static_cast<UINT>(eyeIndex)
+                           : 0;
+    return D3D11CalcSubresource(0, slice, s_textureDesc.MipLevels);
+}
+
 // Renders the view from our Unity cameras by copying data at
 // Unity.RenderTexture.GetNativeTexturePtr() to RenderManager colorBuffers
 void RenderViewD3D11(const osvr::renderkit::RenderInfo &ri,
@@ -740,138 +2567,852 @@ void RenderViewD3D11(const osvr::renderkit::RenderInfo &ri,
 	context->OMSetRenderTargets(1, &renderTargetView, NULL);
 
 	// copy the updated RenderTexture from Unity to RenderManager colorBuffer
+	if (static_cast<std::size_t>(eyeIndex) < s_eyeCopiesD3D11.size() &&
+		s_eyeCopiesD3D11[eyeIndex] != nullptr) {
+		// RenderManager reads our 2D copy of this eye (or its array slice).
+		context->CopySubresourceRegion(
+			s_eyeCopiesD3D11[eyeIndex], 0, 0, 0, 0,
+			GetEyeTextureD3D11(eyeIndex), EyeSubresourceD3D11(eyeIndex),
+			nullptr);
+		return;
+	}
 	s_renderBuffers[eyeIndex].D3D11->colorBuffer = GetEyeTextureD3D11(eyeIndex);
 }
+
+/// Copies Unity's texture for @p eyeIndex into its shared copy in @p set, on
+/// Unity's immediate context, and hands the copy to the presenting side.
+inline void CopyToSharedEyeD3D11(int eyeIndex, std::size_t set) {
+    const auto index = static_cast<std::size_t>(eyeIndex) *
+                           static_cast<std::size_t>(s_eyeCopySets) +
+                       set;
+    if (index >= s_sharedEyeCopiesD3D11.size()) {
+        return;
+    }
+    auto &copy = s_sharedEyeCopiesD3D11[index];
+    // Waits until the presenting side hands the copy back.
+    copy.mutex->AcquireSync(RenderThreadKey, INFINITE);
+    s_library.D3D11->context->CopySubresourceRegion(
+        copy.texture, 0, 0, 0, 0, GetEyeTextureD3D11(eyeIndex),
+        EyeSubresourceD3D11(eyeIndex), nullptr);
+    copy.mutex->ReleaseSync(PresentThreadKey);
+}
+
+/// Presenting side of the shared copies in @p set: take them from the render
+/// thread, and release them with @p key once presented (RenderThreadKey hands
+/// them back, PresentThreadKey keeps them for presenting again).
+inline void AcquireSharedEyeCopiesD3D11(std::size_t set) {
+    const auto sets = static_cast<std::size_t>(s_eyeCopySets);
+    for (auto i = set; sets > 0 && i < s_sharedEyeCopiesD3D11.size();
+         i += sets) {
+        s_sharedEyeCopiesD3D11[i].presentMutex->AcquireSync(PresentThreadKey,
+                                                            INFINITE);
+    }
+}
+inline void ReleaseSharedEyeCopiesD3D11(std::size_t set, UINT64 key) {
+    const auto sets = static_cast<std::size_t>(s_eyeCopySets);
+    for (auto i = set; sets > 0 && i < s_sharedEyeCopiesD3D11.size();
+         i += sets) {
+        s_sharedEyeCopiesD3D11[i].presentMutex->ReleaseSync(key);
+    }
+}
+
+/// Render thread: take back the copies in @p set after the frame they held
+/// was dropped without being presented.
+inline void ReclaimSharedEyeCopiesD3D11(std::size_t set) {
+    const auto sets = static_cast<std::size_t>(s_eyeCopySets);
+    for (auto i = set; sets > 0 && i < s_sharedEyeCopiesD3D11.size();
+         i += sets) {
+        s_sharedEyeCopiesD3D11[i].mutex->AcquireSync(PresentThreadKey,
+                                                     INFINITE);
+        s_sharedEyeCopiesD3D11[i].mutex->ReleaseSync(RenderThreadKey);
+    }
+}
 #endif // SUPPORT_D3D11
 
 #if SUPPORT_OPENGL
-// Render the world from the specified point of view.
-//@todo This is not functional yet.
-inline void RenderViewOpenGL(
-    const osvr::renderkit::RenderInfo &ri, //< Info needed to render
-    GLuint frameBufferObj, //< Frame buffer object to bind our buffers to
-    GLuint colorBuffer,    //< Color buffer to render into
-    int eyeIndex) {
-    // Render to our framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBufferObj);
-
-    // Set color and depth buffers for the frame buffer
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, colorBuffer, 0);
-    // glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
-    // GL_RENDERBUFFER, depthBuffer);
-
-    // Set the list of draw buffers.
-    GLenum DrawBuffers[1] = {GL_COLOR_ATTACHMENT0};
-    glDrawBuffers(1, DrawBuffers); // "1" is the size of DrawBuffers
-
-    // Always check that our framebuffer is ok
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        DebugLog("RenderView: Incomplete Framebuffer");
+// Makes Unity's rendered texture for this eye available to RenderManager.
+// Usually Unity's texture is registered directly and there is nothing to do;
+// otherwise this is a single framebuffer blit into our RGBA8 copy.
+inline void RenderViewOpenGL(int eyeIndex) {
+    if (static_cast<std::size_t>(eyeIndex) >= s_openGLEyeCopies.size()) {
+        return;
+    }
+    const auto &eyeCopy = s_openGLEyeCopies[eyeIndex];
+    if (eyeCopy.target == 0 || !eyeCopy.complete) {
         return;
     }
 
-    // Set the viewport to cover our entire render texture.
-    glViewport(0, 0, static_cast<GLsizei>(ri.viewport.width),
-               static_cast<GLsizei>(ri.viewport.height));
-
-    // Set the OpenGL projection matrix
-    GLdouble projection[16];
-    osvr::renderkit::OSVR_Projection_to_OpenGL(projection, ri.projection);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glMultMatrixd(projection);
-
-    /// Put the transform into the OpenGL ModelView matrix
-    GLdouble modelView[16];
-    osvr::renderkit::OSVR_PoseState_to_OpenGL(modelView, ri.pose);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-    glMultMatrixd(modelView);
-
-    // Clear the screen to red and clear depth
-    glClearColor(1, 0, 0, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    // =================================================================
-    // This is where we draw our world and hands and any other objects.
-    // We're in World Space.  To find out about where to render objects
-    // in OSVR spaces (like left/right hand space) we need to query the
-    // interface and handle the coordinate tranforms ourselves.
-
-    // update native texture from code
-    glBindTexture(GL_TEXTURE_2D,
-                  s_renderBuffers[eyeIndex].OpenGL->colorBufferName);
-    int texWidth, texHeight;
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texWidth);
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texHeight);
-
-    GLuint glTex = eyeIndex == 0 ? (GLuint)s_leftEyeTexturePtr
-                                 : (GLuint)s_rightEyeTexturePtr;
-
-    // unsigned char* data = new unsigned char[texWidth*texHeight * 4];
-    // FillTextureFromCode(texWidth, texHeight, texHeight * 4, data);
-    // glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texWidth, texHeight, GL_RGBA,
-    // GL_UNSIGNED_BYTE, (GLuint));
-    // delete[] data;
-    // Draw a cube with a 5-meter radius as the room we are floating in.
-    // draw_cube(5.0);
+    /// @todo Restoring Unity's bindings still costs two glGet calls per eye.
+    GLint previousRead = 0;
+    GLint previousDraw = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+
+    // Attachments were set up and validated in ConstructBuffersOpenGL.
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, eyeCopy.readFrameBuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, eyeCopy.drawFrameBuffer);
+    glBlitFramebuffer(0, 0, eyeCopy.source.width, eyeCopy.source.height, 0, 0,
+                      eyeCopy.source.width, eyeCopy.source.height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousRead));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousDraw));
 }
 #endif // SUPPORT_OPENGL
 
-inline void DoRender() {
-    if (!s_deviceType) {
+/// Fetch the freshest head pose into s_lateLatchedHeadPose. If @p frame's
+/// poses were predicted, predict the fresh one to the same display time, so
+/// timewarp only corrects the prediction instead of undoing it.
+/// @return false if the client context has no usable head pose.
+inline bool LatchHeadPose(PresentToken &frame) {
+    // The client context isn't thread-safe: don't use it while
+    // UpdateRenderInfo does (it may be on another thread in async modes).
+    std::lock_guard<std::mutex> lock(s_renderInfoWriterMutex);
+    if (s_clientContext == nullptr) {
+        return false;
+    }
+    if (frame.predictionTarget != 0 && s_predictedInterfaces[0] != nullptr) {
+        osvrClientUpdate(s_clientContext);
+        OSVR_TimeValue now;
+        osvrTimeValueGetNow(&now);
+        const double latchTime =
+            osvrTimeValueDurationSeconds(&now, &s_predictionEpoch);
+        if (frame.latchTime != 0) {
+            // Presented again (timewarp): this time it is seen as much later
+            // as it is latched later.
+            frame.predictionTarget += latchTime - frame.latchTime;
+        }
+        frame.latchTime = latchTime;
+        OSVR_TimeValue timestamp;
+        OSVR_PoseState pose;
+        if (osvrGetPoseState(s_predictedInterfaces[0], &timestamp, &pose) ==
+            OSVR_RETURN_SUCCESS) {
+            s_posePredictor.addSample(
+                0, osvrTimeValueDurationSeconds(&timestamp, &s_predictionEpoch),
+                pose);
+        }
+        if (!s_posePredictor.hasSamples(0)) {
+            return false;
+        }
+        s_posePredictor.predictAll(frame.predictionTarget,
+                                   &s_lateLatchedHeadPose, 1);
+        return true;
+    }
+    if (s_headInterface == nullptr &&
+        osvrClientGetInterface(s_clientContext, "/me/head",
+                               &s_headInterface) != OSVR_RETURN_SUCCESS) {
+        s_headInterface = nullptr;
+        return false;
+    }
+    osvrClientUpdate(s_clientContext);
+    OSVR_TimeValue timestamp;
+    return osvrGetPoseState(s_headInterface, &timestamp,
+                            &s_lateLatchedHeadPose) == OSVR_RETURN_SUCCESS;
+}
+
+/// Last thing before PresentRenderBuffers: optionally late-latch the head
+/// pose, and stamp the submit time.
+inline void PrepareToPresent(PresentToken &frame) {
+    auto &timing = frame.timing;
+    s_presentParams.roomFromHeadReplace = nullptr;
+    if (frame.lateLatch && LatchHeadPose(frame)) {
+        timing.lateLatch = FrameTimingNow();
+        // Unity rendered with the poses being presented; timewarp warps
+        // from those to this one.
+        s_presentParams.roomFromHeadReplace = &s_lateLatchedHeadPose;
+    }
+    timing.presentSubmit = FrameTimingNow();
+}
+
+/// Send the rendered results to the screen, on whichever thread presents,
+/// and record the frame's timing. With @p handBack false the frame's eye
+/// copies stay with the presenting side, to be presented again.
+template <typename Backend>
+inline void PresentFrame(PresentToken &frame, bool handBack) {
+    auto &timing = frame.timing;
+    Backend::beginPresent(frame.index);
+    PrepareToPresent(frame);
+    const bool presented = s_render->PresentRenderBuffers(
+        frame.renderBuffers, frame.renderInfo, s_presentParams,
+        frame.croppingViewports, Backend::flipInY);
+    Backend::endPresent(frame.index, handBack);
+    if (!presented) {
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] "
+                                     "PresentRenderBuffers() returned false, "
+                                     "maybe because it was asked to quit");
+    }
+    timing.presentReturn = FrameTimingNow();
+    if (timing.renderThreadRelease == 0) {
+        timing.renderThreadRelease = timing.presentReturn;
+    }
+
+    timing.frame = ++s_presentedFrames;
+    s_frameTimings.push(timing);
+    if (s_poseTrace.isOpen()) {
+        PoseTracePresent record = {};
+        record.header.type = kPoseTraceRecord_Present;
+        record.header.time = timing.presentReturn;
+        record.frame = timing.frame;
+        record.success = presented ? 1 : 0;
+        record.lateLatched = timing.lateLatch != 0 ? 1 : 0;
+        record.poseFetch = timing.poseFetch;
+        record.presentSubmit = timing.presentSubmit;
+        s_poseTrace.append(record);
+    }
+    if (timing.poseFetch != 0) {
+        // Present return stands in for photon time: the frame scans out
+        // starting at the vsync it returned on.
+        const double latency =
+            static_cast<double>(timing.presentReturn - timing.poseFetch) * 1e-9;
+        const double previous =
+            s_measuredDisplayLatency.load(std::memory_order_relaxed);
+        s_measuredDisplayLatency.store(
+            previous == 0 ? latency : previous + 0.1 * (latency - previous),
+            std::memory_order_relaxed);
+    }
+    const auto startupBegin = s_startupBegin.exchange(0);
+    if (startupBegin != 0) {
+        s_startupTime.store(timing.presentReturn - startupBegin,
+                            std::memory_order_relaxed);
+    }
+}
+
+inline void StopAsyncPresent() {
+    // Destroying the presenter presents whatever is queued and joins.
+    s_asyncPresenter.reset();
+}
+
+/// Render thread: stop the present and timewarp threads, and wake any
+/// thread pausing them. The timewarp thread retires its frames here too.
+inline void StopPresentThreads() {
+    s_asyncTimewarp.reset();
+    StopAsyncPresent();
+    {
+        std::lock_guard<std::mutex> lock(s_presentThreadsMutex);
+        s_presentThreadsRunning = false;
+    }
+    s_presentThreadsStopped.notify_all();
+}
+
+/// Render thread, before starting a present thread: false while another
+/// thread holds a PresentThreadsPause.
+inline bool MayStartPresentThreads() {
+    std::lock_guard<std::mutex> lock(s_presentThreadsMutex);
+    if (s_presentThreadPauses.load() > 0) {
+        return false;
+    }
+    s_presentThreadsRunning = true;
+    return true;
+}
+
+/// Render thread: whether another thread holds a PresentThreadsPause, in
+/// which case the present threads are stopped for it.
+inline bool PresentThreadsPaused() {
+    if (s_presentThreadPauses.load() == 0) {
+        return false;
+    }
+    if (s_presentThreadsRunning.load()) {
+        StopPresentThreads();
+    }
+    return true;
+}
+
+/// Start, stop or resize the present thread to match what Unity asked for
+/// through SetAsyncPresent. Only ever called on the render thread.
+template <typename Backend> inline void UpdateAsyncPresentMode() {
+    const auto requested = Backend::framesInFlight(static_cast<std::size_t>(
+        s_requestedFramesInFlight.load(std::memory_order_relaxed)));
+    const auto current =
+        s_asyncPresenter ? s_asyncPresenter->framesInFlight() : 0;
+    if (requested == current) {
+        return;
+    }
+    if (requested > 0 && Backend::asyncPresentUnsupported() != nullptr) {
+        PluginLog<LogLevel::Warning>(Backend::asyncPresentUnsupported());
+        s_requestedFramesInFlight.store(0, std::memory_order_relaxed);
         return;
     }
-	std::lock_guard<std::mutex> lock(m_mutex);
-    const auto n = static_cast<int>(s_lastRenderInfo.size());
 
-    switch (s_deviceType.getDeviceTypeEnum()) {
+    StopPresentThreads();
+    if (requested == 0 || !MayStartPresentThreads()) {
+        return;
+    }
+    s_asyncPresenter.reset(
+        new AsyncPresenter(requested, [](PresentToken &frame) {
+            PresentFrame<Backend>(frame, true);
+            ReleaseFrameEyeBuffers(frame);
+        }));
+}
+
+/// Pick the registered buffer @p frame presents for each of @p eyes eyes:
+/// the swap chain buffer the last update event locked in (held for the
+/// frame until ReleaseFrameEyeBuffers), the eye's copy in the frame's set,
+/// or otherwise the eye's only buffer.
+inline void SelectFrameRenderBuffers(std::size_t eyes, PresentToken &frame) {
+    auto &buffers = frame.renderBuffers;
+    buffers.clear();
+    const auto length = static_cast<std::size_t>(s_swapChainLength);
+    const auto sets = static_cast<std::size_t>(s_eyeCopySets);
+    for (std::size_t eye = 0; eye < eyes; ++eye) {
+        auto index = eye;
+        if (length > 0) {
+            const int latched = s_latchedEyeBuffer[eye].load();
+            if (latched < 0) {
+                break;
+            }
+            s_eyeBufferHolds[eye][latched].fetch_add(
+                1, std::memory_order_relaxed);
+            frame.eyeBuffers.push_back(latched);
+            index = eye * length + static_cast<std::size_t>(latched);
+        } else if (sets > 0) {
+            index = eye * sets + frame.index;
+        }
+        if (index >= s_renderBuffers.size()) {
+            break;
+        }
+        buffers.push_back(s_renderBuffers[index]);
+    }
+}
+
+/// Render thread, once per frame: feed the controller the interval since the
+/// last render event, after applying any new SetDynamicResolution settings.
+inline void UpdateDynamicResolution() {
+    const auto now = FrameTimingNow();
+    const auto last = s_lastRenderEventTime;
+    s_lastRenderEventTime = now;
+    if (s_dynamicResolutionChanged.exchange(false)) {
+        std::lock_guard<std::mutex> lock(s_dynamicResolutionMutex);
+        s_dynamicResolution.reset(
+            s_dynamicResolutionEnabled
+                ? new DynamicResolutionController(s_dynamicResolutionConfig)
+                : nullptr);
+        s_nextResolutionScale.store(
+            s_dynamicResolution ? s_dynamicResolution->scale() : 1.0,
+            std::memory_order_relaxed);
+        return;
+    }
+    if (s_dynamicResolution && last != 0) {
+        s_nextResolutionScale.store(
+            s_dynamicResolution->update(static_cast<double>(now - last) *
+                                        1e-9),
+            std::memory_order_relaxed);
+    }
+}
+
+/// The normalized viewports for a frame of @p eyes eyes rendered at
+/// @p scale: the bottom-left part of each eye's full viewport.
+inline void ScaleCroppingViewports(
+    std::size_t eyes, double scale,
+    std::vector<osvr::renderkit::OSVR_ViewportDescription> &viewports) {
+    viewports.clear();
+    if (scale >= 1.0) {
+        viewports.assign(s_croppingViewports.begin(),
+                         s_croppingViewports.end());
+        return;
+    }
+    for (std::size_t eye = 0; eye < eyes; ++eye) {
+        osvr::renderkit::OSVR_ViewportDescription viewport;
+        if (eye < s_croppingViewports.size()) {
+            viewport = s_croppingViewports[eye];
+        } else {
+            viewport.left = 0;
+            viewport.lower = 0;
+            viewport.width = 1;
+            viewport.height = 1;
+        }
+        viewport.width *= scale;
+        viewport.height *= scale;
+        viewports.push_back(viewport);
+    }
+}
+
+/// Timewarp thread body, once per vsync.
+template <typename Backend>
+inline void PresentTimewarpFrame(PresentToken &token, bool fresh) {
+    PresentFrame<Backend>(token, false);
+    if (fresh) {
+        s_freshFrames.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        s_reprojectedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/// Timewarp thread, once a fresher frame replaced @p frame (or the render
+/// thread, when timewarp stops): hand its eye copies back to the render
+/// thread.
+template <typename Backend>
+inline void RetireTimewarpFrame(PresentToken &frame) {
+    Backend::retireFrame(frame.index);
+    ReleaseFrameEyeBuffers(frame);
+}
+
+/// Render thread, once a submitted @p frame was replaced before the timewarp
+/// thread ever presented it: take its eye copies straight back.
+template <typename Backend>
+inline void ReclaimTimewarpFrame(PresentToken &frame) {
+    Backend::reclaimFrame(frame.index);
+    ReleaseFrameEyeBuffers(frame);
+}
+
+/// Start or stop the timewarp thread to match what Unity asked for through
+/// SetAsyncTimewarp. Only ever called on the render thread.
+template <typename Backend> inline void UpdateAsyncTimewarpMode() {
+    const bool requested =
+        s_asyncTimewarpRequested.load(std::memory_order_relaxed);
+    if (requested == static_cast<bool>(s_asyncTimewarp)) {
+        return;
+    }
+    if (!requested) {
+        StopPresentThreads();
+        return;
+    }
+    if (Backend::asyncTimewarp()) {
+        // The timewarp thread is the presenter now.
+        StopPresentThreads();
+        if (!MayStartPresentThreads()) {
+            return;
+        }
+        s_asyncTimewarp.reset(new AsyncTimewarp(PresentTimewarpFrame<Backend>,
+                                                RetireTimewarpFrame<Backend>));
+        return;
+    }
+    PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Asynchronous "
+                                 "timewarp needs Direct3D 11 and "
+                                 "SetAsyncTimewarp before "
+                                 "CreateRenderManagerFromUnity, presenting "
+                                 "from the render thread");
+    s_asyncTimewarpRequested.store(false, std::memory_order_relaxed);
+}
+
+/// The render loop, specialized for one graphics backend (see the policies
+/// below) so the per-API work inlines with no device type checks.
+template <typename Backend> inline void DoRender(bool lateLatch) {
+    // Every present, on whichever thread, starts from here. Nothing is
+    // presented while another thread releases what presents use.
+    if (PresentThreadsPaused() || !RenderManagerReady()) {
+        return;
+    }
+    UpdateDynamicResolution();
+    UpdateAsyncTimewarpMode<Backend>();
+    if (!s_asyncTimewarp) {
+        UpdateAsyncPresentMode<Backend>();
+    }
+    if (PresentThreadsPaused()) {
+        return;
+    }
+
+    // In async mode this is where back-pressure applies: we wait here if the
+    // present thread already has framesInFlight frames. Timewarp always has
+    // a free slot.
+    PresentToken *token = nullptr;
+    if (s_asyncTimewarp) {
+        token = &s_asyncTimewarp->acquire();
+    } else if (s_asyncPresenter) {
+        token = &s_asyncPresenter->acquire();
+    }
+    auto &frame = token ? *token : s_syncFrame;
+    auto &renderInfo = frame.renderInfo;
+
+    OSVR_FrameTiming timing = {};
+    timing.poseFetch = s_lastPoseFetchTime.load(std::memory_order_relaxed);
+    timing.renderTargetSetup = FrameTimingNow();
+    // Take our own copy so nothing is held across PresentRenderBuffers (and
+    // its vsync wait).
+    s_lastRenderInfo.read(renderInfo);
+    SelectFrameRenderBuffers(renderInfo.size(), frame);
+    // Foveated eye buffers are always stitched at full size.
+    ScaleCroppingViewports(
+        renderInfo.size(),
+        s_foveatedBuffers.load(std::memory_order_relaxed)
+            ? 1.0
+            : s_resolutionScale.load(std::memory_order_relaxed),
+        frame.croppingViewports);
+    // Swap chain buffers were rendered into by Unity directly.
+    const auto n =
+        s_swapChainLength > 0 ? 0 : static_cast<int>(renderInfo.size());
+    Backend::renderEyes(renderInfo, n, frame);
+
+    frame.timing = timing;
+    frame.lateLatch = lateLatch;
+    frame.predictionTarget =
+        s_lastPredictionTarget.load(std::memory_order_relaxed);
+    frame.latchTime = 0;
+    if (s_asyncTimewarp) {
+        // Presented (and re-presented) at the timewarp thread's next vsync.
+        frame.timing.renderThreadRelease = FrameTimingNow();
+        if (PresentToken *dropped = s_asyncTimewarp->submit()) {
+            ReclaimTimewarpFrame<Backend>(*dropped);
+        }
+        PresentThreadsPaused();
+        return;
+    }
+    if (s_asyncPresenter) {
+        frame.timing.renderThreadRelease = FrameTimingNow();
+        s_asyncPresenter->submit();
+        // Rather than keep a pausing thread waiting for the next event.
+        PresentThreadsPaused();
+        return;
+    }
+    PresentFrame<Backend>(frame, true);
+    ReleaseFrameEyeBuffers(frame);
+}
+
+// --------------------------------------------------------------------------
+// Graphics backends: one policy struct of static functions per graphics API,
+// from which SelectGraphicsBackend instantiates s_backend. Everything that
+// differs per API in the render loop and the present paths is decided here,
+// at compile time.
+
+/// What a policy doesn't override: no flip, nothing to hand over between
+/// threads around a present, asynchronous present supported and timewarp
+/// not.
+struct BackendDefaults {
+    static const bool flipInY = false;
+    static void recordEyeTexture(int, void *) {}
+    /// On the presenting thread, around each present of the frame in slot
+    /// @p set; with @p handBack false it will be presented again.
+    static void beginPresent(std::size_t) {}
+    static void endPresent(std::size_t /*set*/, bool /*handBack*/) {}
+    /// RetireTimewarpFrame and ReclaimTimewarpFrame's per-API part.
+    static void retireFrame(std::size_t) {}
+    static void reclaimFrame(std::size_t) {}
+    /// Why the present thread can't run, as a log message; nullptr if it
+    /// can.
+    static const char *asyncPresentUnsupported() { return nullptr; }
+    /// How many of the @p requested frames in flight the present thread may
+    /// actually have.
+    static std::size_t framesInFlight(std::size_t requested) {
+        return requested;
+    }
+    static bool asyncTimewarp() { return false; }
+};
+
 #if SUPPORT_D3D11
-    case OSVRSupportedRenderers::D3D11: {
-		// Render into each buffer using the specified information.
-		for (int i = 0; i < n; ++i) {
-			RenderViewD3D11(s_lastRenderInfo[i],
-				s_renderBuffers[i].D3D11->colorBufferView, i);
-		}
-
-        // Send the rendered results to the screen
-        // Flip Y because Unity RenderTextures are upside-down on D3D11
-        if (!s_render->PresentRenderBuffers(
-			s_renderBuffers, s_lastRenderInfo,
-                osvr::renderkit::RenderManager::RenderParams(),
-                std::vector<osvr::renderkit::OSVR_ViewportDescription>(),
-                true)) {
-            DebugLog("[OSVR Rendering Plugin] PresentRenderBuffers() returned "
-                     "false, maybe because it was asked to quit");
+/// Direct3D 11, with RenderManager on Unity's device: Unity's textures (or
+/// swap chain) are copied into, or registered as, RenderManager's buffers on
+/// the render thread, which presents.
+struct D3D11Backend : BackendDefaults {
+    /// Unity's render textures are upside-down on Direct3D 11.
+    static const bool flipInY = true;
+    static void deviceEvent(UnityGfxDeviceEventType eventType) {
+        DoEventGraphicsDeviceD3D11(eventType);
+    }
+    static OSVR_ReturnCode constructBuffers(int eyes) {
+        return applyRenderBufferConstructor(eyes, ConstructBuffersD3D11,
+                                            CleanupBufferD3D11);
+    }
+    static OSVR_ReturnCode constructSwapChain(int buffers) {
+        return applyRenderBufferConstructor(buffers,
+                                            ConstructSwapChainBufferD3D11,
+                                            CleanupSwapChainBufferD3D11);
+    }
+    static OSVR_ReturnCode constructFoveatedBuffers(int) {
+        PluginLog<LogLevel::Warning>("[OSVR Rendering Plugin] Fixed foveation "
+                                     "is only supported on OpenGL.");
+        return OSVR_RETURN_FAILURE;
+    }
+    static void *nativeTexture(const osvr::renderkit::RenderBuffer &rb) {
+        return rb.D3D11->colorBuffer;
+    }
+    static void
+    renderEyes(const std::vector<osvr::renderkit::RenderInfo> &renderInfo,
+               int n, const PresentToken &) {
+        // Render into each buffer using the specified information.
+        for (int i = 0; i < n; ++i) {
+            RenderViewD3D11(renderInfo[i],
+                            s_renderBuffers[i].D3D11->colorBufferView, i);
+        }
+    }
+    static const char *asyncPresentUnsupported() {
+        return "[OSVR Rendering Plugin] Asynchronous present on Direct3D 11 "
+               "must be requested before CreateRenderManagerFromUnity, "
+               "presenting synchronously";
+    }
+};
+
+/// Direct3D 11 with RenderManager on a device of its own, chosen when
+/// asynchronous present or timewarp was requested before it was created:
+/// each frame goes into its slot's set of shared eye copies, which the
+/// render and presenting threads pass back and forth with keyed mutexes, so
+/// the present thread never touches Unity's immediate context.
+struct D3D11PresentDeviceBackend : D3D11Backend {
+    static OSVR_ReturnCode constructBuffers(int eyes) {
+        return ConstructSharedEyeCopiesD3D11(eyes);
+    }
+    static void renderEyes(const std::vector<osvr::renderkit::RenderInfo> &,
+                           int n, const PresentToken &frame) {
+        // Into the frame's own copies, on RenderManager's device.
+        for (int i = 0; i < n && s_eyeCopySets > 0; ++i) {
+            CopyToSharedEyeD3D11(i, frame.index);
         }
-        break;
     }
+    static void beginPresent(std::size_t set) {
+        AcquireSharedEyeCopiesD3D11(set);
+    }
+    static void endPresent(std::size_t set, bool handBack) {
+        ReleaseSharedEyeCopiesD3D11(set,
+                                    handBack ? RenderThreadKey
+                                             : PresentThreadKey);
+    }
+    static void retireFrame(std::size_t set) {
+        AcquireSharedEyeCopiesD3D11(set);
+        ReleaseSharedEyeCopiesD3D11(set, RenderThreadKey);
+    }
+    static void reclaimFrame(std::size_t set) {
+        ReclaimSharedEyeCopiesD3D11(set);
+    }
+    static const char *asyncPresentUnsupported() { return nullptr; }
+    /// No more frames in flight than sets of eye copies to present from.
+    static std::size_t framesInFlight(std::size_t requested) {
+        const auto sets = static_cast<std::size_t>(s_eyeCopySets);
+        return requested < sets ? requested : sets;
+    }
+    /// The timewarp thread needs a set of copies per slot, set up when
+    /// ConstructRenderBuffers saw the request.
+    static bool asyncTimewarp() {
+        return s_eyeCopySets >= static_cast<int>(AsyncTimewarp::Slots);
+    }
+};
 #endif // SUPPORT_D3D11
 
 #if SUPPORT_OPENGL
-    case OSVRSupportedRenderers::OpenGL: {
-        // OpenGL
-        //@todo OpenGL path is not working yet
-        // Render into each buffer using the specified information.
-
+struct OpenGLBackend : BackendDefaults {
+    static void deviceEvent(UnityGfxDeviceEventType eventType) {
+        DoEventGraphicsDeviceOpenGL(eventType);
+    }
+    static OSVR_ReturnCode constructBuffers(int eyes) {
+        return applyRenderBufferConstructor(eyes, ConstructBuffersOpenGL,
+                                            CleanupBufferOpenGL);
+    }
+    static OSVR_ReturnCode constructSwapChain(int buffers) {
+        return applyRenderBufferConstructor(buffers,
+                                            ConstructSwapChainBufferOpenGL,
+                                            CleanupSwapChainBufferOpenGL);
+    }
+    static OSVR_ReturnCode constructFoveatedBuffers(int eyes) {
+        return applyRenderBufferConstructor(eyes, ConstructFoveatedBufferOpenGL,
+                                            CleanupFoveatedBufferOpenGL);
+    }
+    static void *nativeTexture(const osvr::renderkit::RenderBuffer &rb) {
+        return reinterpret_cast<void *>(
+            static_cast<std::uintptr_t>(rb.OpenGL->colorBufferName));
+    }
+    static void recordEyeTexture(int eye, void *texturePtr) {
+        RecordEyeTextureOpenGL(eye, texturePtr);
+    }
+    static void
+    renderEyes(const std::vector<osvr::renderkit::RenderInfo> &, int n,
+               const PresentToken &) {
+        // Hand each eye's Unity texture to RenderManager, or build the eye
+        // buffer from its foveated regions.
+        if (!s_foveatedBuffers.load(std::memory_order_relaxed)) {
+            for (int i = 0; i < n; ++i) {
+                RenderViewOpenGL(i);
+            }
+            return;
+        }
+        std::lock_guard<std::mutex> lock(s_foveationMutex);
         for (int i = 0; i < n; ++i) {
-            RenderViewOpenGL(s_renderInfo[i], s_frameBuffer,
-                             s_renderBuffers[i].OpenGL->colorBufferName, i);
+            StitchFoveatedEyeOpenGL(i);
         }
+    }
+    /// RenderManager's GL context is current on the render thread only.
+    static const char *asyncPresentUnsupported() {
+        return "[OSVR Rendering Plugin] Asynchronous present is not "
+               "supported on OpenGL, presenting synchronously";
+    }
+};
+#endif // SUPPORT_OPENGL
+
+/// No graphics device, for the headless render backends: buffers carry no
+/// textures and there is nothing to render. Each buffer still gets an
+/// OpenGL buffer struct (naming no texture) so that backends can tell the
+/// registered buffers apart.
+struct HeadlessBackend : BackendDefaults {
+    static void deviceEvent(UnityGfxDeviceEventType) {}
+    static OSVR_ReturnCode constructBuffer(int) {
+        osvr::renderkit::RenderBuffer rb;
+        rb.OpenGL = new osvr::renderkit::RenderBufferOpenGL;
+        rb.OpenGL->colorBufferName = 0;
+        s_renderBuffers.push_back(rb);
+        return OSVR_RETURN_SUCCESS;
+    }
+    static void cleanupBuffer(osvr::renderkit::RenderBuffer &rb) {
+        delete rb.OpenGL;
+        rb.OpenGL = nullptr;
+    }
+    static OSVR_ReturnCode constructBuffers(int eyes) {
+        return applyRenderBufferConstructor(eyes, constructBuffer,
+                                            cleanupBuffer);
+    }
+    static OSVR_ReturnCode constructSwapChain(int buffers) {
+        return applyRenderBufferConstructor(buffers, constructBuffer,
+                                            cleanupBuffer);
+    }
+    static OSVR_ReturnCode constructFoveatedBuffers(int) {
+        return OSVR_RETURN_FAILURE;
+    }
+    /// No texture: the buffer struct stands in for one, so hosts can still
+    /// tell the buffers apart.
+    static void *nativeTexture(const osvr::renderkit::RenderBuffer &rb) {
+        return rb.OpenGL;
+    }
+    static void
+    renderEyes(const std::vector<osvr::renderkit::RenderInfo> &, int,
+               const PresentToken &) {}
+    /// There are no eye buffers for timewarp to protect.
+    static bool asyncTimewarp() { return true; }
+};
 
-        // Send the rendered results to the screen
-        if (!s_render->PresentRenderBuffers(s_renderBuffers, s_renderInfo)) {
-            DebugLog("PresentRenderBuffers() returned false, maybe because "
-                     "it was asked to quit");
+/// The table of @p Backend's operations.
+template <typename Backend>
+inline const GraphicsBackend *GraphicsBackendFor() {
+    static const GraphicsBackend backend = {
+        &Backend::deviceEvent,
+        &Backend::constructBuffers,
+        &Backend::constructSwapChain,
+        &Backend::constructFoveatedBuffers,
+        &Backend::nativeTexture,
+        &Backend::recordEyeTexture,
+        &DoRender<Backend>,
+    };
+    return &backend;
+}
+
+inline void SelectGraphicsBackend(UnityRendererType renderer) {
+    const GraphicsBackend *backend = nullptr;
+    if (renderer) {
+        switch (renderer.getDeviceTypeEnum()) {
+#if SUPPORT_D3D11
+        case OSVRSupportedRenderers::D3D11:
+            backend = s_separatePresentDeviceD3D11
+                          ? GraphicsBackendFor<D3D11PresentDeviceBackend>()
+                          : GraphicsBackendFor<D3D11Backend>();
+            break;
+#endif
+#if SUPPORT_OPENGL
+        case OSVRSupportedRenderers::OpenGL:
+            backend = GraphicsBackendFor<OpenGLBackend>();
+            break;
+#endif
+        case OSVRSupportedRenderers::Headless:
+            backend = GraphicsBackendFor<HeadlessBackend>();
+            break;
+        case OSVRSupportedRenderers::EmptyRenderer:
+        default:
+            break;
         }
-        break;
     }
-#endif // SUPPORT_OPENGL
+    s_backend.store(backend);
+}
 
-    case OSVRSupportedRenderers::EmptyRenderer:
-    default:
-        break;
+void UNITY_INTERFACE_API SetDynamicResolution(int enable, double minScale,
+                                              double targetFrameSeconds) {
+    std::lock_guard<std::mutex> lock(s_dynamicResolutionMutex);
+    s_dynamicResolutionEnabled = enable != 0;
+    s_dynamicResolutionConfig = DynamicResolutionConfig();
+    if (minScale > 0 && minScale <= 1) {
+        s_dynamicResolutionConfig.minScale = minScale;
+    }
+    if (targetFrameSeconds > 0) {
+        s_dynamicResolutionConfig.targetFrameSeconds = targetFrameSeconds;
+    }
+    s_dynamicResolutionChanged = true;
+}
+
+double UNITY_INTERFACE_API GetResolutionScale() {
+    return s_resolutionScale.load(std::memory_order_relaxed);
+}
+
+void UNITY_INTERFACE_API SetAsyncPresent(int framesInFlight) {
+    s_requestedFramesInFlight.store(framesInFlight > 0 ? framesInFlight : 0,
+                                    std::memory_order_relaxed);
+}
+
+void UNITY_INTERFACE_API SetAsyncTimewarp(int enable) {
+    s_asyncTimewarpRequested.store(enable != 0, std::memory_order_relaxed);
+}
+
+uint64_t UNITY_INTERFACE_API GetFreshFrameCount() {
+    return s_freshFrames.load(std::memory_order_relaxed);
+}
+
+uint64_t UNITY_INTERFACE_API GetReprojectedFrameCount() {
+    return s_reprojectedFrames.load(std::memory_order_relaxed);
+}
+
+int UNITY_INTERFACE_API GetFrameTimings(OSVR_FrameTiming *buffer,
+                                        int count) {
+    if (buffer == nullptr || count <= 0) {
+        return 0;
+    }
+    return static_cast<int>(
+        s_frameTimings.pop(buffer, static_cast<std::size_t>(count)));
+}
+
+int64_t UNITY_INTERFACE_API GetLastDeviceResetRecoveryTime() {
+    return s_lastDeviceResetRecovery.load(std::memory_order_relaxed);
+}
+
+void UNITY_INTERFACE_API SetPredictionLeadTime(double seconds) {
+    s_predictionLeadTime.store(seconds, std::memory_order_relaxed);
+}
+
+int UNITY_INTERFACE_API AddPredictedDevice(const char *path) {
+    std::lock_guard<std::mutex> lock(s_renderInfoWriterMutex);
+    if (path == nullptr || s_clientContext == nullptr ||
+        s_predictedDeviceCount >= PosePredictor::MaxDevices) {
+        return -1;
+    }
+    const auto device = s_predictedDeviceCount;
+    if (osvrClientGetInterface(s_clientContext, path,
+                               &s_predictedInterfaces[device]) !=
+        OSVR_RETURN_SUCCESS) {
+        s_predictedInterfaces[device] = nullptr;
+        return -1;
+    }
+    ++s_predictedDeviceCount;
+    return static_cast<int>(device);
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API GetPredictedPose(int device,
+                                                     OSVR_PoseState *pose) {
+    if (pose == nullptr || device < 0 ||
+        device >= static_cast<int>(PosePredictor::MaxDevices)) {
+        return OSVR_RETURN_FAILURE;
+    }
+    std::lock_guard<std::mutex> lock(s_predictedPosesMutex);
+    if (!s_posePredictor.hasSamples(static_cast<std::size_t>(device))) {
+        return OSVR_RETURN_FAILURE;
+    }
+    *pose = s_predictedPoses[device];
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode UNITY_INTERFACE_API StartPoseTrace(const char *path,
+                                                   int megabytes) {
+    if (megabytes <= 0 ||
+        !s_poseTrace.open(path, static_cast<std::size_t>(megabytes) << 20,
+                          FrameTimingNow())) {
+        PluginLog<LogLevel::Error>("[OSVR Rendering Plugin] Could not start "
+                                   "pose trace");
+        return OSVR_RETURN_FAILURE;
     }
+    return OSVR_RETURN_SUCCESS;
+}
+
+void UNITY_INTERFACE_API StopPoseTrace() { s_poseTrace.close(); }
+
+uint64_t UNITY_INTERFACE_API GetDroppedPoseTraceRecords() {
+    return s_poseTrace.dropped();
+}
+
+int64_t UNITY_INTERFACE_API GetStartupTime() {
+    return s_startupTime.load(std::memory_order_relaxed);
+}
+
+uint64_t UNITY_INTERFACE_API GetDroppedFrameTimings() {
+    return s_frameTimings.dropped();
 }
 
 // --------------------------------------------------------------------------
@@ -885,17 +3426,36 @@ void UNITY_INTERFACE_API OnRenderEvent(int eventID) {
     if (!s_deviceType) {
         return;
     }
+    s_renderThread = std::this_thread::get_id();
+    if (s_shutdownPending) {
+        // Now that the present thread can be stopped.
+        ShutdownRenderManager();
+    }
+    if (s_poseTrace.isOpen()) {
+        PoseTraceRenderEvent record = {};
+        record.header.type = kPoseTraceRecord_RenderEvent;
+        record.header.time = FrameTimingNow();
+        record.eventID = eventID;
+        s_poseTrace.append(record);
+    }
 
     switch (eventID) {
     // Call the Render loop
     case kOsvrEventID_Render:
-        DoRender();
+        s_backend.load()->render(false);
+        break;
+    case kOsvrEventID_RenderLateLatch:
+        s_backend.load()->render(true);
         break;
     case kOsvrEventID_Shutdown:
+        StopPresentThreads();
         break;
     case kOsvrEventID_Update:
         UpdateRenderInfo();
         break;
+    case kOsvrEventID_FinishCreateRenderManager:
+        FinishCreateRenderManagerAsync();
+        break;
     case kOsvrEventID_SetRoomRotationUsingHead: //"recenter"
 		osvrResetYaw();
 		//SetRoomRotationUsingHead();
@@ -29,8 +29,159 @@ Sensics, Inc.
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ReturnCodesC.h>
 #include <osvr/ResetYaw/ResetYaw.h>
+
+#include <stdint.h>
 typedef void(UNITY_INTERFACE_API *DebugFnPtr)(const char *);
 
+/// Render event IDs, for GL.IssuePluginEvent with GetRenderEventFunc.
+enum RenderEvents {
+    kOsvrEventID_Render = 0,
+    /// Stops the present thread (SetAsyncPresent) or timewarp thread
+    /// (SetAsyncTimewarp), after it presents what it holds. Issue it before
+    /// ShutdownRenderManager; a later render event starts the thread again.
+    kOsvrEventID_Shutdown = 1,
+    kOsvrEventID_Update = 2,
+    kOsvrEventID_SetRoomRotationUsingHead = 3,
+    kOsvrEventID_ClearRoomToWorldTransform = 4,
+    /// Like kOsvrEventID_Render, but re-reads the head pose just before
+    /// presenting so timewarp corrects towards the freshest tracker data
+    /// (predicted to the same display time, with SetPredictionLeadTime).
+    kOsvrEventID_RenderLateLatch = 5,
+    /// Completes CreateRenderManagerFromUnityAsync on the render thread.
+    kOsvrEventID_FinishCreateRenderManager = 6
+};
+
+/// Progress of RenderManager creation, from GetRenderManagerStatus.
+enum RenderManagerStatus {
+    /// Not created (or shut down).
+    kOsvrRenderManagerStatus_None = 0,
+    /// CreateRenderManagerFromUnityAsync's worker thread is still busy.
+    kOsvrRenderManagerStatus_Creating = 1,
+    /// Waiting for the kOsvrEventID_FinishCreateRenderManager render event.
+    kOsvrRenderManagerStatus_WaitingForRenderThread = 2,
+    /// Ready for ConstructRenderBuffers and rendering.
+    kOsvrRenderManagerStatus_Ready = 3,
+    /// Creation failed; see the log.
+    kOsvrRenderManagerStatus_Failed = 4
+};
+
+/// The regions of a fixed-foveated eye, for the GetFoveatedRegion* calls.
+enum FoveatedRegions {
+    /// The whole eye, rendered at reduced density.
+    kOsvrFoveatedRegion_Periphery = 0,
+    /// The part around the optical axis, rendered at full density.
+    kOsvrFoveatedRegion_Center = 1
+};
+
+/// Which part of an eye buffer GetHiddenAreaMesh returns.
+enum HiddenAreaMeshTypes {
+    /// The pixels no display pixel samples: draw into depth or stencil first
+    /// so they are never shaded.
+    kOsvrHiddenAreaMesh_Hidden = 0,
+    /// The rest of the buffer.
+    kOsvrHiddenAreaMesh_Visible = 1
+};
+
+/// How Unity's eye images are laid out in the texture(s) handed to the plugin.
+enum EyeBufferLayouts {
+    /// One texture per eye, each set with SetColorBufferFromUnity.
+    kOsvrEyeBufferLayout_Separate = 0,
+    /// One double-wide texture, left eye in the left half (single-pass
+    /// stereo).
+    kOsvrEyeBufferLayout_SideBySide = 1,
+    /// One 2-slice texture array, slice 0 for the left eye (single-pass
+    /// instanced stereo).
+    kOsvrEyeBufferLayout_TextureArray = 2
+};
+
+/// Most eyes reported by GetFrameState.
+#define OSVR_FRAME_STATE_MAX_EYES 8
+
+/// Everything Unity needs to render one eye, as returned individually by
+/// GetEyePose, GetProjectionMatrix and GetViewport.
+struct OSVR_EyeState {
+    OSVR_Pose3 pose;
+    osvr::renderkit::OSVR_ProjectionMatrix projection;
+    osvr::renderkit::OSVR_ViewportDescription viewport;
+};
+
+/// Plain-old-data snapshot of all eyes, filled in by GetFrameState. All eyes
+/// come from the same RenderInfo update, identified by @c sequence.
+/// Aligned to a cache line; callers should provide a buffer aligned likewise.
+struct alignas(64) OSVR_FrameState {
+    /// Increases by one with every render info update; 0 means none yet.
+    uint64_t sequence;
+    /// Number of valid entries in @c eyes.
+    int32_t eyeCount;
+    int32_t reserved;
+    OSVR_EyeState eyes[OSVR_FRAME_STATE_MAX_EYES];
+};
+
+/// One eye's matrices in Unity's conventions, as Unity's Matrix4x4 lays them
+/// out in memory (column-major floats), so they can be marshaled straight
+/// into Matrix4x4 and Plane arrays.
+struct OSVR_EyeMatrices {
+    /// For Camera.worldToCameraMatrix.
+    float view[16];
+    /// For Camera.projectionMatrix.
+    float projection[16];
+    /// projection * view.
+    float viewProjection[16];
+    /// Left, right, bottom, top, near and far planes as normal x, y, z and
+    /// distance, in GeometryUtility.CalculateFrustumPlanes order.
+    float frustumPlanes[6][4];
+};
+
+/// All eyes' matrices from one render info update, filled in by
+/// GetFrameMatrices.
+struct alignas(64) OSVR_FrameMatrices {
+    /// As OSVR_FrameState::sequence.
+    uint64_t sequence;
+    /// Number of valid entries in @c eyes.
+    int32_t eyeCount;
+    int32_t reserved;
+    OSVR_EyeMatrices eyes[OSVR_FRAME_STATE_MAX_EYES];
+};
+
+/// One camera whose frustum encloses every eye's, filled in by
+/// GetCombinedCullingFrustum.
+struct OSVR_CullingFrustum {
+    /// As OSVR_FrameState::sequence.
+    uint64_t sequence;
+    /// The combined camera's matrices and planes. Set viewProjection as
+    /// Camera.cullingMatrix to cull once for all eyes.
+    OSVR_EyeMatrices matrices;
+    /// Volume, in cubic meters, inside the combined frustum but outside
+    /// every eye's, or -1 if not measured.
+    float extraVolume;
+    /// extraVolume as a fraction of the volume the eyes see, or -1 if not
+    /// measured.
+    float extraVolumeFraction;
+};
+
+/// Timestamps for one presented frame, in nanoseconds on a monotonic clock
+/// (only differences between them are meaningful).
+struct OSVR_FrameTiming {
+    /// Counts presented frames, starting at 1.
+    uint64_t frame;
+    /// When the render info (poses) used by this frame was fetched.
+    int64_t poseFetch;
+    /// When the render thread started setting up the eye render targets.
+    int64_t renderTargetSetup;
+    /// When the head pose was late-latched for timewarp, or 0 if this frame
+    /// was not rendered with kOsvrEventID_RenderLateLatch. The pose age saved
+    /// is lateLatch - poseFetch.
+    int64_t lateLatch;
+    /// When the buffers were submitted to PresentRenderBuffers.
+    int64_t presentSubmit;
+    /// When PresentRenderBuffers returned.
+    int64_t presentReturn;
+    /// When the render thread was done with this frame and returned to
+    /// Unity: presentReturn when presenting synchronously, much earlier with
+    /// SetAsyncPresent.
+    int64_t renderThreadRelease;
+};
+
 extern "C" {
 
 // No apparent UpdateDistortionMeshes symbol found?
@@ -39,14 +190,122 @@ extern "C" {
 /// stdcall - yet somehow the managed code refers to some as cdecl. Either those
 /// functions are never getting used, or something else is happening there.
 
+/// (Re)builds the eye buffers. Called on any thread but the render thread
+/// while a present thread is running, it waits (up to a second) for the
+/// render thread to stop it at its next render event, and fails if none
+/// comes.
 UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
 ConstructRenderBuffers();
 
+/// Makes subsequent CreateRenderManagerFromUnity calls use a simulated
+/// RenderManager that needs no HMD or OSVR server, with @p eyeCount eyes, a
+/// simulated vsync every @p vsyncIntervalSeconds and poses that are
+/// @p trackerLatencySeconds old. Pass an eyeCount of 0 to go back to the real
+/// RenderManager.
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API
+ConfigureStandInRenderBackend(int eyeCount, double vsyncIntervalSeconds,
+                              double trackerLatencySeconds);
+
+/// Makes subsequent CreateRenderManagerFromUnity calls use a RenderManager
+/// that plays back the pose trace at @p tracePath (see StartPoseTrace): each
+/// update event gets the next recorded poses, and presents return at the
+/// recorded present times if @p paced, otherwise at once. With no Unity
+/// graphics device, the stand-in and replay backends run headless. Pass a
+/// null or empty path to go back to the real RenderManager.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+ConfigureTraceReplayBackend(const char *tracePath, int paced);
+
 UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
 CreateRenderManagerFromUnity(OSVR_ClientContext context);
 
+/// Like CreateRenderManagerFromUnity, but returns at once: RenderManager is
+/// created (and on Direct3D 11, its display opened) on a worker thread. Poll
+/// GetRenderManagerStatus; once it reports
+/// kOsvrRenderManagerStatus_WaitingForRenderThread, issue the
+/// kOsvrEventID_FinishCreateRenderManager render event to do the rest (on
+/// OpenGL, opening the display) on the render thread.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+CreateRenderManagerFromUnityAsync(OSVR_ClientContext context);
+
+/// Pose prediction lead time: 0 (the default) renders with the latest
+/// tracker report, > 0 predicts poses this many seconds past each update
+/// event, < 0 predicts to the measured time from update to display.
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API
+SetPredictionLeadTime(double seconds);
+
+/// Also predict the pose of the device at @p path (e.g.
+/// "/me/hands/left") on each update event. Returns its index for
+/// GetPredictedPose, or -1. Index 0 is always the head.
+UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API
+AddPredictedDevice(const char *path);
+
+/// The pose of predicted device @p device from the last update event.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+GetPredictedPose(int device, OSVR_PoseState *pose);
+
+/// One of RenderManagerStatus.
+UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API GetRenderManagerStatus();
+
+/// Nanoseconds from the last CreateRenderManagerFromUnity(Async) call that
+/// started creating RenderManager to the first frame presented after it, or
+/// 0 if none has been yet.
+UNITY_INTERFACE_EXPORT int64_t UNITY_INTERFACE_API GetStartupTime();
+
 UNITY_INTERFACE_EXPORT OSVR_Pose3 UNITY_INTERFACE_API GetEyePose(int eye);
 
+/// Fills @p state with every eye's pose, projection and viewport from one
+/// consistent render info update. Returns failure if @p state is null or no
+/// render info is available yet, or (in practice never) if updates kept
+/// overwriting it faster than it could be copied. Never waits for an update.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+GetFrameState(OSVR_FrameState *state);
+
+/// Like GetFrameState, but with each eye converted to Unity's view,
+/// projection and view-projection matrices and culling planes. Pass a
+/// non-zero @p flipY to negate clip-space Y, for rendering into Direct3D
+/// render textures. Returns failure if @p matrices is null or no render info
+/// is available yet.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+GetFrameMatrices(OSVR_FrameMatrices *matrices, int flipY);
+
+/// Computes one conservative frustum enclosing every eye's, from the same
+/// render info GetFrameState reports, for a single culling pass. A non-zero
+/// @p measureExtraVolume also estimates how much more than the eyes it
+/// takes in, at a few hundred microseconds' cost. Returns failure if
+/// @p frustum is null or no render info is available yet.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+GetCombinedCullingFrustum(OSVR_CullingFrustum *frustum,
+                          int measureExtraVolume);
+
+/// Copies up to @p maxVertices vertices of @p eye's hidden or visible area
+/// mesh (see HiddenAreaMeshTypes) into @p vertices, as x, y float pairs in
+/// the eye buffer's 0 to 1 coordinates (y up, as GL.LoadOrtho sets up),
+/// three vertices per triangle. Returns the mesh's full vertex count, so a
+/// null @p vertices just sizes the buffer; or -1 if there is no mesh for
+/// the current display. The meshes are built from the display descriptor's
+/// lens distortion on first use. The descriptor is reread only when the
+/// eyes' viewports change, and the meshes are rebuilt only if the
+/// distortion it gives changed. The hidden mesh covers what the distortion
+/// never samples and, for a descriptor with a field of view, the corners
+/// outside a round lens (see BuildHiddenAreaMesh).
+UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API
+GetHiddenAreaMesh(int eye, int type, float *vertices, int maxVertices);
+
+/// Copies up to @p count of the oldest not-yet-read frame timing records into
+/// @p buffer and returns how many were copied. Poll it regularly: the plugin
+/// keeps only a fixed number of records and overwrites the oldest.
+UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API
+GetFrameTimings(OSVR_FrameTiming *buffer, int count);
+
+/// Number of frame timing records overwritten before GetFrameTimings read
+/// them.
+UNITY_INTERFACE_EXPORT uint64_t UNITY_INTERFACE_API GetDroppedFrameTimings();
+
+/// Nanoseconds from the last graphics device BeforeReset until the plugin had
+/// rebuilt its render buffers for the reset device, or 0 if none yet.
+UNITY_INTERFACE_EXPORT int64_t UNITY_INTERFACE_API
+GetLastDeviceResetRecoveryTime();
+
 UNITY_INTERFACE_EXPORT osvr::renderkit::OSVR_ProjectionMatrix
     UNITY_INTERFACE_API
     GetProjectionMatrix(int eye);
@@ -60,12 +319,139 @@ UNITY_INTERFACE_EXPORT osvr::renderkit::OSVR_ViewportDescription
 
 UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API LinkDebug(DebugFnPtr d);
 
+/// Record every GetRenderInfo result, render event and present outcome, with
+/// timestamps, into a new trace file at @p path (replacing it), until
+/// StopPoseTrace. The file is preallocated to @p megabytes; records past
+/// that are dropped. Read it with osvrPoseTraceDump.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+StartPoseTrace(const char *path, int megabytes);
+
+/// Finish the pose trace (trimming the file to what was recorded).
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API StopPoseTrace();
+
+/// Number of pose trace records dropped because the file was full.
+UNITY_INTERFACE_EXPORT uint64_t UNITY_INTERFACE_API
+GetDroppedPoseTraceRecords();
+
+/// Deliver queued log messages to the LinkDebug callback and the log file
+/// now, on the calling thread, instead of waiting for the log thread.
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API FlushLog();
+
+/// Number of log messages dropped because the log queue was full.
+UNITY_INTERFACE_EXPORT uint64_t UNITY_INTERFACE_API GetDroppedLogRecordCount();
+
 UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API OnRenderEvent(int eventID);
 
 /// @todo should return OSVR_ReturnCode
 UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API
 SetColorBufferFromUnity(void *texturePtr, int eye);
 
+/// Sets a single texture holding both eyes, laid out as @p layout (one of
+/// EyeBufferLayouts other than kOsvrEyeBufferLayout_Separate), for Unity's
+/// single-pass stereo. Call before ConstructRenderBuffers.
+/// @todo should return OSVR_ReturnCode
+UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API
+SetStereoColorBufferFromUnity(void *texturePtr, int layout);
+
+/// With @p framesInFlight > 0, render events only queue the frame and a
+/// plugin-owned thread presents it, so Unity's render thread doesn't wait for
+/// vsync; the render thread blocks only once that many frames are queued.
+/// 0 (the default) presents synchronously. Takes effect on the next render
+/// event. Not supported on OpenGL, which always presents synchronously. On
+/// Direct3D 11, call before CreateRenderManagerFromUnity: RenderManager then
+/// gets a device of its own and presents copies of the eye textures, one set
+/// per frame in flight as requested at ConstructRenderBuffers (which caps it).
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API
+SetAsyncPresent(int framesInFlight);
+
+/// Dynamic resolution: with @p enable non-zero, the plugin watches the
+/// interval between render events and scales the rendered part of each eye
+/// buffer between @p minScale and 1 (full size) to hold
+/// @p targetFrameSeconds (0 for 90 Hz). Buffers are never reallocated.
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API
+SetDynamicResolution(int enable, double minScale, double targetFrameSeconds);
+
+/// The fraction of each eye buffer's width and height to render this frame:
+/// set the eye cameras' viewport rect to (0, 0, scale, scale), scaled within
+/// each eye's half for side-by-side. Latched with
+/// the poses by each update event, so it matches GetEyePose/GetViewport.
+UNITY_INTERFACE_EXPORT double UNITY_INTERFACE_API GetResolutionScale();
+
+/// With @p count > 0, the next ConstructRenderBuffers creates a swap chain
+/// of @p count plugin-owned RGBA8 eye buffers per eye, at each eye's viewport
+/// size, instead of using the textures set from Unity. Unity then renders
+/// each frame into the buffer AcquireEyeBuffer returns, so it never writes
+/// to a buffer RenderManager is still reading. Use at least frames in flight
+/// plus one (two for async timewarp), and at most 8. 0 (the default) turns
+/// it off.
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetEyeBufferCount(int count);
+
+/// Advance @p eye to the next swap chain buffer that no frame is using and
+/// return its index. The next update event locks in the buffer last
+/// acquired, and the render events after it present that one, whatever is
+/// acquired meanwhile. -1 if there is no swap chain, or if every buffer is
+/// still locked in or presenting (the swap chain is too short for the frames
+/// in flight).
+UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API AcquireEyeBuffer(int eye);
+
+/// The native texture (ID3D11Texture2D * or OpenGL texture name) of swap
+/// chain buffer @p index for @p eye, for Texture2D.CreateExternalTexture.
+/// Headless, an opaque handle that names no texture.
+UNITY_INTERFACE_EXPORT void *UNITY_INTERFACE_API
+GetEyeBufferTexture(int eye, int index);
+
+/// Fixed foveation: with @p centerFraction in (0, 1), the next
+/// ConstructRenderBuffers gives each eye two plugin-owned render targets
+/// instead of using the textures set from Unity: a center region covering
+/// @p centerFraction of the eye's width and height around its optical axis,
+/// at full density, and the whole eye at @p peripheryScale of full density.
+/// Each render event stitches them into the eye buffer RenderManager
+/// presents, taking from the periphery only what lies outside the center
+/// (see GetFoveatedPeripheryMask). 0 turns it off. OpenGL only; fails on
+/// Direct3D 11.
+UNITY_INTERFACE_EXPORT OSVR_ReturnCode UNITY_INTERFACE_API
+SetFixedFoveation(double centerFraction, double peripheryScale);
+
+/// The projection to render foveated @p region of @p eye with.
+UNITY_INTERFACE_EXPORT osvr::renderkit::OSVR_ProjectionMatrix
+    UNITY_INTERFACE_API
+    GetFoveatedRegionProjectionMatrix(int eye, int region);
+
+/// The size of foveated @p region's render target for @p eye, at (0, 0).
+UNITY_INTERFACE_EXPORT osvr::renderkit::OSVR_ViewportDescription
+    UNITY_INTERFACE_API
+    GetFoveatedRegionViewport(int eye, int region);
+
+/// The part of @p eye's periphery render target the stitch never reads, in
+/// its pixels: the center region, shrunk by the texels upscaling around it
+/// samples. Unity can skip shading it, with a scissor rect, stencil or a
+/// near-plane depth quad. Empty if not foveated.
+UNITY_INTERFACE_EXPORT osvr::renderkit::OSVR_ViewportDescription
+    UNITY_INTERFACE_API
+    GetFoveatedPeripheryMask(int eye);
+
+/// The OpenGL texture name of foveated @p region's render target for @p eye,
+/// for Texture2D.CreateExternalTexture; null if not foveated.
+UNITY_INTERFACE_EXPORT void *UNITY_INTERFACE_API
+GetFoveatedRegionTexture(int eye, int region);
+
+/// Asynchronous timewarp: with @p enable non-zero, a high-priority plugin
+/// thread presents at every vsync, re-presenting the last completed frame
+/// with the freshest head pose whenever Unity hasn't delivered a new one.
+/// Render events then only hand frames over. Call before
+/// CreateRenderManagerFromUnity: on Direct3D 11, RenderManager then gets a
+/// device of its own, and ConstructRenderBuffers a set of eye copies for each
+/// frame the timewarp thread may hold. Direct3D 11 (and the headless
+/// backends) only; overrides SetAsyncPresent while active.
+UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetAsyncTimewarp(int enable);
+
+/// Number of new frames from Unity the timewarp thread has presented.
+UNITY_INTERFACE_EXPORT uint64_t UNITY_INTERFACE_API GetFreshFrameCount();
+
+/// Number of times the timewarp thread re-presented a frame because Unity
+/// hadn't delivered a new one in time.
+UNITY_INTERFACE_EXPORT uint64_t UNITY_INTERFACE_API GetReprojectedFrameCount();
+
 UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API
 SetFarClipDistance(double distance);
 
@@ -73,6 +459,11 @@ UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetIPD(double ipdMeters);
 
 UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API
 SetNearClipDistance(double distance);
+
+/// Called on any thread but the render thread while a present thread is
+/// running, waits like ConstructRenderBuffers; if no render event stops the
+/// thread in time, the next render event finishes the shutdown, and
+/// RenderManager can't be created again until then.
 UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API ShutdownRenderManager();
 
 UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API
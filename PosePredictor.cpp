@@ -0,0 +1,203 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PosePredictor.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+const double PosePredictor::VelocityWindowSeconds = 0.05;
+const double PosePredictor::MaxPredictionSeconds = 0.1;
+
+PosePredictor::PosePredictor() {
+    for (std::size_t i = 0; i < MaxDevices; ++i) {
+        reset(i);
+    }
+}
+
+void PosePredictor::addSample(std::size_t device, double time,
+                              const OSVR_PoseState &pose) {
+    if (device >= MaxDevices) {
+        return;
+    }
+    auto &history = history_[device];
+    if (history.size > 0 && time <= history.samples[history.newest].time) {
+        return;
+    }
+    history.newest = (history.newest + 1) % HistoryLength;
+    history.samples[history.newest].time = time;
+    history.samples[history.newest].pose = pose;
+    // Not std::min, here and below: it would bind a reference to the
+    // constant, which has no definition outside the class.
+    if (history.size < HistoryLength) {
+        ++history.size;
+    }
+
+    valid_[device] = 1;
+    time_[device] = time;
+    px_[device] = osvrVec3GetX(&pose.translation);
+    py_[device] = osvrVec3GetY(&pose.translation);
+    pz_[device] = osvrVec3GetZ(&pose.translation);
+    qw_[device] = osvrQuatGetW(&pose.rotation);
+    qx_[device] = osvrQuatGetX(&pose.rotation);
+    qy_[device] = osvrQuatGetY(&pose.rotation);
+    qz_[device] = osvrQuatGetZ(&pose.rotation);
+    updateVelocity_(device);
+}
+
+bool PosePredictor::hasSamples(std::size_t device) const {
+    return device < MaxDevices && history_[device].size > 0;
+}
+
+void PosePredictor::reset(std::size_t device) {
+    if (device >= MaxDevices) {
+        return;
+    }
+    history_[device] = History();
+    valid_[device] = 0;
+    time_[device] = 0;
+    px_[device] = py_[device] = pz_[device] = 0;
+    qw_[device] = 1;
+    qx_[device] = qy_[device] = qz_[device] = 0;
+    vx_[device] = vy_[device] = vz_[device] = 0;
+    wx_[device] = wy_[device] = wz_[device] = 0;
+}
+
+void PosePredictor::updateVelocity_(std::size_t device) {
+    vx_[device] = vy_[device] = vz_[device] = 0;
+    wx_[device] = wy_[device] = wz_[device] = 0;
+
+    // Find the oldest sample inside the velocity window.
+    const auto &history = history_[device];
+    const auto &newest = history.samples[history.newest];
+    const Sample *oldest = nullptr;
+    for (std::size_t age = 1; age < history.size; ++age) {
+        const auto &sample =
+            history.samples[(history.newest + HistoryLength - age) %
+                            HistoryLength];
+        if (newest.time - sample.time > VelocityWindowSeconds) {
+            break;
+        }
+        oldest = &sample;
+    }
+    if (oldest == nullptr) {
+        return;
+    }
+    const double dt = newest.time - oldest->time;
+
+    vx_[device] = (osvrVec3GetX(&newest.pose.translation) -
+                   osvrVec3GetX(&oldest->pose.translation)) /
+                  dt;
+    vy_[device] = (osvrVec3GetY(&newest.pose.translation) -
+                   osvrVec3GetY(&oldest->pose.translation)) /
+                  dt;
+    vz_[device] = (osvrVec3GetZ(&newest.pose.translation) -
+                   osvrVec3GetZ(&oldest->pose.translation)) /
+                  dt;
+
+    // Room-frame rotation from oldest to newest: newest * conj(oldest).
+    const auto &a = newest.pose.rotation;
+    const auto &b = oldest->pose.rotation;
+    const double aw = osvrQuatGetW(&a), ax = osvrQuatGetX(&a),
+                 ay = osvrQuatGetY(&a), az = osvrQuatGetZ(&a);
+    const double bw = osvrQuatGetW(&b), bx = -osvrQuatGetX(&b),
+                 by = -osvrQuatGetY(&b), bz = -osvrQuatGetZ(&b);
+    double dw = aw * bw - ax * bx - ay * by - az * bz;
+    double dx = aw * bx + ax * bw + ay * bz - az * by;
+    double dy = aw * by - ax * bz + ay * bw + az * bx;
+    double dz = aw * bz + ax * by - ay * bx + az * bw;
+    if (dw < 0) {
+        // Take the short way around.
+        dw = -dw;
+        dx = -dx;
+        dy = -dy;
+        dz = -dz;
+    }
+    const double sinHalf = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (sinHalf < 1e-12) {
+        return;
+    }
+    const double angle = 2 * std::atan2(sinHalf, dw);
+    const double scale = angle / (sinHalf * dt);
+    wx_[device] = dx * scale;
+    wy_[device] = dy * scale;
+    wz_[device] = dz * scale;
+}
+
+void PosePredictor::predictAll(double time, OSVR_PoseState *poses,
+                               std::size_t count) const {
+    if (count > MaxDevices) {
+        count = MaxDevices;
+    }
+    double px[MaxDevices], py[MaxDevices], pz[MaxDevices];
+    double qw[MaxDevices], qx[MaxDevices], qy[MaxDevices], qz[MaxDevices];
+    // All devices, not just count: a fixed trip count needs no scalar
+    // epilogue, so GCC vectorizes this at -O2 too. The sqrt only vectorizes
+    // where it needn't set errno (PosePredictor.cpp's flags in CMakeLists).
+    for (std::size_t i = 0; i < MaxDevices; ++i) {
+        const double dt = valid_[i] *
+                          std::min(std::max(time - time_[i], 0.0),
+                                   MaxPredictionSeconds);
+        px[i] = px_[i] + vx_[i] * dt;
+        py[i] = py_[i] + vy_[i] * dt;
+        pz[i] = pz_[i] + vz_[i] * dt;
+
+        // Rotation by w * dt as a quaternion, from the Taylor series of
+        // cos(theta/2) and sin(theta/2)/theta - accurate to well under a
+        // millidegree for anything a head or hand turns in MaxPrediction.
+        const double rx = wx_[i] * dt, ry = wy_[i] * dt, rz = wz_[i] * dt;
+        const double theta2 = rx * rx + ry * ry + rz * rz;
+        const double c = 1 - theta2 / 8 + theta2 * theta2 / 384;
+        const double s = 0.5 - theta2 / 48 + theta2 * theta2 / 3840;
+        const double dw = c, dx = rx * s, dy = ry * s, dz = rz * s;
+
+        // Apply it in the room frame: d * q.
+        const double w = dw * qw_[i] - dx * qx_[i] - dy * qy_[i] - dz * qz_[i];
+        const double x = dw * qx_[i] + dx * qw_[i] + dy * qz_[i] - dz * qy_[i];
+        const double y = dw * qy_[i] - dx * qz_[i] + dy * qw_[i] + dz * qx_[i];
+        const double z = dw * qz_[i] + dx * qy_[i] - dy * qx_[i] + dz * qw_[i];
+        const double norm = 1 / std::sqrt(w * w + x * x + y * y + z * z);
+        qw[i] = w * norm;
+        qx[i] = x * norm;
+        qy[i] = y * norm;
+        qz[i] = z * norm;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (valid_[i] == 0) {
+            continue;
+        }
+        osvrVec3SetX(&poses[i].translation, px[i]);
+        osvrVec3SetY(&poses[i].translation, py[i]);
+        osvrVec3SetZ(&poses[i].translation, pz[i]);
+        osvrQuatSetW(&poses[i].rotation, qw[i]);
+        osvrQuatSetX(&poses[i].rotation, qx[i]);
+        osvrQuatSetY(&poses[i].rotation, qy[i]);
+        osvrQuatSetZ(&poses[i].rotation, qz[i]);
+    }
+}
@@ -0,0 +1,100 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PosePredictor_h_GUID_7C3F1A58_0E2B_4D96_A4C7_85B9E21D6F03
+#define INCLUDED_PosePredictor_h_GUID_7C3F1A58_0E2B_4D96_A4C7_85B9E21D6F03
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/Util/Pose3C.h>
+
+// Standard includes
+#include <cstddef>
+
+/// Extrapolates tracked device poses to a future time from a short history
+/// of tracker reports, assuming constant linear and angular velocity.
+///
+/// Velocities are estimated when samples arrive; prediction then is plain
+/// arithmetic over structure-of-arrays state for all devices at once (no
+/// branches, and sqrt as the only library call), which compilers vectorize
+/// when sqrt needn't set errno.
+class PosePredictor {
+  public:
+    static const std::size_t MaxDevices = 8;
+    static const std::size_t HistoryLength = 8;
+    /// Velocities come from the span between the newest sample and the
+    /// oldest one at most this old: long enough to average out tracker
+    /// noise, short enough to follow changes in motion.
+    static const double VelocityWindowSeconds;
+    /// Predictions are never extrapolated further than this ahead of the
+    /// newest sample.
+    static const double MaxPredictionSeconds;
+
+    PosePredictor();
+
+    /// Record a tracker report for @p device, at @p time seconds on the same
+    /// clock later passed to predictAll. Reports no newer than the device's
+    /// newest are ignored (e.g. an unchanged state read again).
+    void addSample(std::size_t device, double time, const OSVR_PoseState &pose);
+
+    /// Whether @p device has any samples (and so gets predicted).
+    bool hasSamples(std::size_t device) const;
+
+    /// Forget @p device's history.
+    void reset(std::size_t device);
+
+    /// Extrapolate each of the first @p count devices that has samples to
+    /// @p time, into poses[device]; other entries are left alone.
+    void predictAll(double time, OSVR_PoseState *poses,
+                    std::size_t count) const;
+
+  private:
+    struct Sample {
+        double time;
+        OSVR_PoseState pose;
+    };
+    struct History {
+        Sample samples[HistoryLength];
+        std::size_t newest = 0;
+        std::size_t size = 0;
+    };
+    void updateVelocity_(std::size_t device);
+
+    History history_[MaxDevices];
+
+    // Newest sample and velocity estimates, structure-of-arrays across
+    // devices for predictAll. valid_ is 1 for devices with samples, else 0.
+    double valid_[MaxDevices];
+    double time_[MaxDevices];
+    double px_[MaxDevices], py_[MaxDevices], pz_[MaxDevices];
+    double qw_[MaxDevices], qx_[MaxDevices], qy_[MaxDevices], qz_[MaxDevices];
+    /// Linear velocity, meters per second.
+    double vx_[MaxDevices], vy_[MaxDevices], vz_[MaxDevices];
+    /// Angular velocity in the room frame, radians per second.
+    double wx_[MaxDevices], wy_[MaxDevices], wz_[MaxDevices];
+};
+
+#endif // INCLUDED_PosePredictor_h_GUID_7C3F1A58_0E2B_4D96_A4C7_85B9E21D6F03
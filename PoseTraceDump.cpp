@@ -0,0 +1,103 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseTraceReader.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdio>
+
+/// Prints a pose trace written by StartPoseTrace as text, one record per
+/// line, with times in milliseconds since recording started.
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s <trace file>\n", argv[0]);
+        return 1;
+    }
+    PoseTraceReader trace;
+    if (!trace.load(argv[1])) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], trace.error().c_str());
+        return 1;
+    }
+    if (!trace.complete()) {
+        std::printf("# trace was not closed; reading up to the first empty "
+                    "record\n");
+    }
+    const auto startTime = trace.header().startTime;
+    const auto ms = [&](std::int64_t time) {
+        return static_cast<double>(time - startTime) * 1e-6;
+    };
+
+    std::size_t records = 0;
+    trace.visit([&](const PoseTraceRecordHeader &rh, const char *record) {
+        switch (rh.type) {
+        case kPoseTraceRecord_RenderInfo: {
+            PoseTraceRenderInfo r;
+            PoseTraceReader::read(rh, record, r);
+            std::printf("%12.3f renderinfo eye %u pos %.5f %.5f %.5f "
+                        "rot %.5f %.5f %.5f %.5f "
+                        "proj %.4f %.4f %.4f %.4f %.3f %.1f "
+                        "viewport %.0f %.0f %.0f %.0f\n",
+                        ms(rh.time), r.eye, r.translation[0],
+                        r.translation[1], r.translation[2], r.rotation[0],
+                        r.rotation[1], r.rotation[2], r.rotation[3],
+                        r.projection[0], r.projection[1], r.projection[2],
+                        r.projection[3], r.projection[4], r.projection[5],
+                        r.viewport[0], r.viewport[1], r.viewport[2],
+                        r.viewport[3]);
+            break;
+        }
+        case kPoseTraceRecord_RenderEvent: {
+            PoseTraceRenderEvent r;
+            PoseTraceReader::read(rh, record, r);
+            std::printf("%12.3f event %d\n", ms(rh.time), r.eventID);
+            break;
+        }
+        case kPoseTraceRecord_Present: {
+            PoseTracePresent r;
+            PoseTraceReader::read(rh, record, r);
+            std::printf("%12.3f present frame %llu %s%s pose age %.3f ms "
+                        "submit %.3f ms\n",
+                        ms(rh.time), static_cast<unsigned long long>(r.frame),
+                        r.success ? "ok" : "FAILED",
+                        r.lateLatched ? " late-latched" : "",
+                        r.poseFetch != 0
+                            ? static_cast<double>(rh.time - r.poseFetch) * 1e-6
+                            : 0.0,
+                        ms(r.presentSubmit));
+            break;
+        }
+        default:
+            std::printf("%12.3f unknown record type %u\n", ms(rh.time),
+                        static_cast<unsigned>(rh.type));
+            break;
+        }
+        ++records;
+    });
+    std::printf("# %zu records\n", records);
+    return 0;
+}
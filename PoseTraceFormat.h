@@ -0,0 +1,121 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseTraceFormat_h_GUID_6A3F9D20_B1C4_4E87_9F52_0C8E7D41A6B3
+#define INCLUDED_PoseTraceFormat_h_GUID_6A3F9D20_B1C4_4E87_9F52_0C8E7D41A6B3
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdint>
+
+/// On-disk layout of a pose trace: a PoseTraceFileHeader, then records, each
+/// starting with a PoseTraceRecordHeader, back to back. All fields are
+/// little-endian; times are FrameTimingNow() nanoseconds. Kept free of OSVR
+/// types so the dumper builds without the SDK.
+
+/// "OSVRPTRC"
+static const char PoseTraceMagic[8] = {'O', 'S', 'V', 'R',
+                                       'P', 'T', 'R', 'C'};
+/// Bump on any layout change; readers reject other versions.
+static const std::uint32_t PoseTraceVersion = 1;
+/// PoseTraceFileHeader::recordBytes until the trace is closed.
+static const std::uint64_t PoseTraceUnclosed = ~std::uint64_t(0);
+
+struct PoseTraceFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    /// Bytes of whole records after the header; written when the trace is
+    /// closed. PoseTraceUnclosed in a trace that wasn't (the process died):
+    /// read records until one with type 0, since the rest of the file is
+    /// zero-filled.
+    std::uint64_t recordBytes;
+    /// When recording started.
+    std::int64_t startTime;
+};
+
+enum PoseTraceRecordType : std::uint16_t {
+    /// End of the records in an unclosed trace.
+    kPoseTraceRecord_None = 0,
+    /// PoseTraceRenderInfo: one eye of a GetRenderInfo result.
+    kPoseTraceRecord_RenderInfo = 1,
+    /// PoseTraceRenderEvent: a render event from Unity.
+    kPoseTraceRecord_RenderEvent = 2,
+    /// PoseTracePresent: the outcome of a PresentRenderBuffers call.
+    kPoseTraceRecord_Present = 3
+};
+
+struct PoseTraceRecordHeader {
+    std::uint16_t type;
+    /// Of the whole record, header included, so readers can skip types they
+    /// don't know.
+    std::uint16_t size;
+    std::uint32_t reserved;
+    std::int64_t time;
+};
+
+struct PoseTraceRenderInfo {
+    PoseTraceRecordHeader header;
+    std::uint32_t eye;
+    std::uint32_t reserved;
+    /// Eye pose in room space: translation, then rotation as w, x, y, z.
+    double translation[3];
+    double rotation[4];
+    /// left, right, top, bottom, near, far
+    double projection[6];
+    /// left, lower, width, height in pixels
+    double viewport[4];
+};
+
+struct PoseTraceRenderEvent {
+    PoseTraceRecordHeader header;
+    std::int32_t eventID;
+    std::uint32_t reserved;
+};
+
+struct PoseTracePresent {
+    PoseTraceRecordHeader header;
+    /// Counts presented frames, as OSVR_FrameTiming::frame.
+    std::uint64_t frame;
+    /// Non-zero if PresentRenderBuffers succeeded.
+    std::uint32_t success;
+    std::uint32_t lateLatched;
+    /// From the frame's OSVR_FrameTiming.
+    std::int64_t poseFetch;
+    std::int64_t presentSubmit;
+};
+
+// The layout is the file format: no compiler-dependent padding.
+static_assert(sizeof(PoseTraceFileHeader) == 32, "pose trace layout");
+static_assert(sizeof(PoseTraceRecordHeader) == 16, "pose trace layout");
+static_assert(sizeof(PoseTraceRenderInfo) == 160, "pose trace layout");
+static_assert(sizeof(PoseTraceRenderEvent) == 24, "pose trace layout");
+static_assert(sizeof(PoseTracePresent) == 48, "pose trace layout");
+
+#endif // INCLUDED_PoseTraceFormat_h_GUID_6A3F9D20_B1C4_4E87_9F52_0C8E7D41A6B3
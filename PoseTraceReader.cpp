@@ -0,0 +1,70 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseTraceReader.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+bool PoseTraceReader::load(const char *path) {
+    data_.clear();
+    end_ = 0;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error_ = "could not open file";
+        return false;
+    }
+    data_.assign(std::istreambuf_iterator<char>(in),
+                 std::istreambuf_iterator<char>());
+    if (data_.size() < sizeof(header_)) {
+        error_ = "not a pose trace: too short";
+        return false;
+    }
+    std::memcpy(&header_, data_.data(), sizeof(header_));
+    if (std::memcmp(header_.magic, PoseTraceMagic, sizeof(PoseTraceMagic)) !=
+        0) {
+        error_ = "not a pose trace: bad magic";
+        return false;
+    }
+    if (header_.version != PoseTraceVersion ||
+        header_.headerSize < sizeof(header_) ||
+        header_.headerSize > data_.size()) {
+        error_ = "unsupported pose trace version " +
+                 std::to_string(header_.version);
+        return false;
+    }
+    end_ = data_.size();
+    if (complete()) {
+        end_ = static_cast<std::size_t>(std::min<std::uint64_t>(
+            end_, header_.headerSize + header_.recordBytes));
+    }
+    error_.clear();
+    return true;
+}
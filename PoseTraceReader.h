@@ -0,0 +1,89 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseTraceReader_h_GUID_4C81E6B9_7A2D_43F0_A5C3_E9B02D6F1847
+#define INCLUDED_PoseTraceReader_h_GUID_4C81E6B9_7A2D_43F0_A5C3_E9B02D6F1847
+
+// Internal Includes
+#include "PoseTraceFormat.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// Loads a whole pose trace written by PoseTraceRecorder and walks its
+/// records.
+class PoseTraceReader {
+  public:
+    /// Read and validate @p path.
+    /// @return false, with a reason in error(), if it isn't a readable trace
+    /// of this version.
+    bool load(const char *path);
+
+    const PoseTraceFileHeader &header() const { return header_; }
+    const std::string &error() const { return error_; }
+
+    /// False if the trace wasn't closed, so its records were read up to the
+    /// first empty one.
+    bool complete() const { return header_.recordBytes != PoseTraceUnclosed; }
+
+    /// Call @p f(const PoseTraceRecordHeader &, const char *record) for each
+    /// record, in order; @p record points at the record's first byte.
+    template <typename F> void visit(F &&f) const {
+        std::size_t offset = header_.headerSize;
+        while (offset + sizeof(PoseTraceRecordHeader) <= end_) {
+            PoseTraceRecordHeader rh;
+            std::memcpy(&rh, data_.data() + offset, sizeof(rh));
+            if (rh.type == kPoseTraceRecord_None || rh.size < sizeof(rh) ||
+                offset + rh.size > end_) {
+                return;
+            }
+            f(rh, data_.data() + offset);
+            offset += rh.size;
+        }
+    }
+
+    /// Copy a record's bytes into @p out (zero-filled if a shorter, older
+    /// record).
+    template <typename Record>
+    static void read(const PoseTraceRecordHeader &rh, const char *record,
+                     Record &out) {
+        out = Record();
+        std::memcpy(&out, record,
+                    rh.size < sizeof(Record) ? rh.size : sizeof(Record));
+    }
+
+  private:
+    PoseTraceFileHeader header_ = {};
+    std::vector<char> data_;
+    std::size_t end_ = 0;
+    std::string error_;
+};
+
+#endif // INCLUDED_PoseTraceReader_h_GUID_4C81E6B9_7A2D_43F0_A5C3_E9B02D6F1847
@@ -0,0 +1,179 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseTraceRecorder.h"
+
+// Library/third-party includes
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+
+bool PoseTraceRecorder::open(const char *path, std::size_t capacityBytes,
+                             std::int64_t startTime) {
+    close();
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    if (path == nullptr || capacityBytes < sizeof(PoseTraceFileHeader)) {
+        return false;
+    }
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    // Mapping a view of this size extends the file to it.
+    const auto size = static_cast<std::uint64_t>(capacityBytes);
+    HANDLE mapping = CreateFileMappingA(
+        file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+        static_cast<DWORD>(size & 0xffffffffu), nullptr);
+    void *view = mapping != nullptr
+                     ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0)
+                     : nullptr;
+    if (view == nullptr) {
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+#else
+    int file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        return false;
+    }
+    const auto size = static_cast<off_t>(capacityBytes);
+    int flags = MAP_SHARED;
+#ifdef __linux__
+    // Allocate the blocks and fault the pages in now, not while recording.
+    bool extended = posix_fallocate(file, 0, size) == 0;
+    flags |= MAP_POPULATE;
+#else
+    bool extended = false;
+#endif
+    if (!extended && ftruncate(file, size) != 0) {
+        ::close(file);
+        return false;
+    }
+    void *view = mmap(nullptr, capacityBytes, PROT_READ | PROT_WRITE, flags,
+                      file, 0);
+    if (view == MAP_FAILED) {
+        ::close(file);
+        return false;
+    }
+    file_ = file;
+#endif
+    base_ = static_cast<char *>(view);
+    capacity_ = capacityBytes;
+
+    PoseTraceFileHeader header = {};
+    std::copy(PoseTraceMagic, PoseTraceMagic + sizeof(PoseTraceMagic),
+              header.magic);
+    header.version = PoseTraceVersion;
+    header.headerSize = sizeof(PoseTraceFileHeader);
+    header.recordBytes = PoseTraceUnclosed;
+    header.startTime = startTime;
+    std::memcpy(base_, &header, sizeof(header));
+    used_.store(sizeof(header));
+    recordEnd_.store(capacityBytes);
+    dropped_.store(0);
+    open_.store(true);
+    return true;
+}
+
+void PoseTraceRecorder::close() {
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    if (!open_.load()) {
+        return;
+    }
+    open_.store(false);
+    // Appends check open_ after announcing themselves in writers_, so once
+    // this drains, no one is touching the mapping.
+    while (writers_.load() != 0) {
+        std::this_thread::yield();
+    }
+    // Past the first dropped record, the file is zero-filled.
+    const auto end = std::min(used_.load(), recordEnd_.load());
+    const std::uint64_t recordBytes = end - sizeof(PoseTraceFileHeader);
+    std::memcpy(base_ + offsetof(PoseTraceFileHeader, recordBytes),
+                &recordBytes, sizeof(recordBytes));
+    unmap_(end);
+}
+
+void PoseTraceRecorder::appendBytes_(const void *record, std::size_t size) {
+    writers_.fetch_add(1);
+    if (open_.load()) {
+        const auto offset = used_.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size <= capacity_) {
+            std::memcpy(base_ + offset, record, size);
+        } else {
+            // Reservations are contiguous, so the lowest dropped offset is
+            // where the whole records end.
+            auto end = recordEnd_.load(std::memory_order_relaxed);
+            while (offset < end &&
+                   !recordEnd_.compare_exchange_weak(end, offset)) {
+            }
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    writers_.fetch_sub(1);
+}
+
+void PoseTraceRecorder::unmap_(std::uint64_t fileBytes) {
+#ifdef _WIN32
+    UnmapViewOfFile(base_);
+    CloseHandle(mapping_);
+    LARGE_INTEGER length;
+    length.QuadPart = static_cast<long long>(fileBytes);
+    if (SetFilePointerEx(file_, length, nullptr, FILE_BEGIN)) {
+        SetEndOfFile(file_);
+    }
+    CloseHandle(file_);
+    file_ = nullptr;
+    mapping_ = nullptr;
+#else
+    munmap(base_, capacity_);
+    if (ftruncate(file_, static_cast<off_t>(fileBytes)) != 0) {
+        // Still readable: the header says where the records end.
+    }
+    ::close(file_);
+    file_ = -1;
+#endif
+    base_ = nullptr;
+    capacity_ = 0;
+}
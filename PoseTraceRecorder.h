@@ -0,0 +1,101 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseTraceRecorder_h_GUID_D27B5E83_04F9_4A1C_B6E8_93C1F50A2D7E
+#define INCLUDED_PoseTraceRecorder_h_GUID_D27B5E83_04F9_4A1C_B6E8_93C1F50A2D7E
+
+// Internal Includes
+#include "PoseTraceFormat.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/// Appends pose trace records to a memory-mapped file whose full extent is
+/// allocated when it is opened, so appending is a reservation and a memcpy:
+/// no locks, allocation or I/O on the recording threads. Any thread may
+/// append while the trace is open; appends to a closed or full trace are
+/// dropped.
+class PoseTraceRecorder {
+  public:
+    PoseTraceRecorder() = default;
+    ~PoseTraceRecorder() { close(); }
+
+    PoseTraceRecorder(PoseTraceRecorder const &) = delete;
+    PoseTraceRecorder &operator=(PoseTraceRecorder const &) = delete;
+
+    /// Create (or replace) @p path, @p capacityBytes long, and start
+    /// recording into it. Closes any trace already open.
+    bool open(const char *path, std::size_t capacityBytes,
+              std::int64_t startTime);
+
+    /// Stop recording, record the length in the header and trim the file to
+    /// it. Waits for appends already under way.
+    void close();
+
+    bool isOpen() const { return open_.load(std::memory_order_relaxed); }
+
+    /// Any thread: copy @p record (one of the PoseTrace* record structs,
+    /// header filled in except for size) into the trace.
+    template <typename Record> void append(Record &record) {
+        record.header.size = static_cast<std::uint16_t>(sizeof(Record));
+        appendBytes_(&record, sizeof(Record));
+    }
+
+    /// Records dropped because the trace was full.
+    std::uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void appendBytes_(const void *record, std::size_t size);
+    void unmap_(std::uint64_t recordBytes);
+
+    std::mutex controlMutex_; //< serializes open/close
+    std::atomic<bool> open_{false};
+    /// Appends between checking open_ and finishing their copy; close waits
+    /// for this to drain before unmapping.
+    std::atomic<int> writers_{0};
+    char *base_ = nullptr;
+    std::size_t capacity_ = 0;
+    /// Bytes reserved so far, header included.
+    std::atomic<std::size_t> used_{0};
+    /// End of the last whole record once a record has been dropped for want
+    /// of space, else capacity_.
+    std::atomic<std::size_t> recordEnd_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+#ifdef _WIN32
+    void *file_ = nullptr;
+    void *mapping_ = nullptr;
+#else
+    int file_ = -1;
+#endif
+};
+
+#endif // INCLUDED_PoseTraceRecorder_h_GUID_D27B5E83_04F9_4A1C_B6E8_93C1F50A2D7E
@@ -0,0 +1,78 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RenderBackend.h"
+#include "StandInRenderBackend.h"
+#include "TraceReplayBackend.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+enum class BackendKind { RenderManager, StandIn, TraceReplay };
+static BackendKind s_backendKind = BackendKind::RenderManager;
+static StandInRenderBackendConfig s_standInConfig;
+static TraceReplayBackendConfig s_traceReplayConfig;
+
+void useStandInRenderBackend(StandInRenderBackendConfig const &config) {
+    s_standInConfig = config;
+    s_backendKind = BackendKind::StandIn;
+}
+
+void useTraceReplayBackend(TraceReplayBackendConfig const &config) {
+    s_traceReplayConfig = config;
+    s_backendKind = BackendKind::TraceReplay;
+}
+
+void useRenderManagerBackend() {
+    s_backendKind = BackendKind::RenderManager;
+    s_traceReplayConfig = TraceReplayBackendConfig();
+}
+
+bool usingHeadlessRenderBackend() {
+    return s_backendKind != BackendKind::RenderManager;
+}
+
+RenderBackend *createRenderBackend(OSVR_ClientContext context,
+                                   const std::string &renderLibraryName,
+                                   osvr::renderkit::GraphicsLibrary
+                                       graphicsLibrary) {
+    switch (s_backendKind) {
+    case BackendKind::StandIn:
+        return new StandInRenderBackend(s_standInConfig, graphicsLibrary);
+    case BackendKind::TraceReplay:
+        return new TraceReplayBackend(s_traceReplayConfig, graphicsLibrary);
+    case BackendKind::RenderManager:
+        break;
+    }
+    auto render = osvr::renderkit::createRenderManager(
+        context, renderLibraryName, graphicsLibrary);
+    if (render == nullptr) {
+        return nullptr;
+    }
+    return new RenderManagerBackend(render);
+}
@@ -0,0 +1,126 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RenderBackend_h_GUID_8F2D6B04_3E1A_47C9_B5D2_0C7A9E41F638
+#define INCLUDED_RenderBackend_h_GUID_8F2D6B04_3E1A_47C9_B5D2_0C7A9E41F638
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/RenderKit/RenderManager.h>
+#include <osvr/Util/ClientOpaqueTypesC.h>
+
+// Standard includes
+#include <memory>
+#include <string>
+#include <vector>
+
+/// The subset of osvr::renderkit::RenderManager the plugin uses, so that
+/// something other than a real RenderManager (and HMD) can stand behind it.
+/// Method names and semantics match RenderManager's, except that
+/// GetRenderInfo fills a caller-owned vector instead of returning a new one.
+class RenderBackend {
+  public:
+    using RenderManager = osvr::renderkit::RenderManager;
+    using RenderBuffer = osvr::renderkit::RenderBuffer;
+    using RenderInfo = osvr::renderkit::RenderInfo;
+    using OSVR_ViewportDescription = osvr::renderkit::OSVR_ViewportDescription;
+
+    virtual ~RenderBackend() = default;
+
+    virtual bool doingOkay() = 0;
+
+    virtual RenderManager::OpenResults OpenDisplay() = 0;
+
+    /// Replace the contents of @p renderInfo, reusing its storage.
+    virtual void GetRenderInfo(const RenderManager::RenderParams &params,
+                               std::vector<RenderInfo> &renderInfo) = 0;
+
+    virtual bool
+    RegisterRenderBuffers(const std::vector<RenderBuffer> &buffers) = 0;
+
+    virtual bool PresentRenderBuffers(
+        const std::vector<RenderBuffer> &buffers,
+        const std::vector<RenderInfo> &renderInfoUsed,
+        const RenderManager::RenderParams &renderParams,
+        const std::vector<OSVR_ViewportDescription> &normalizedCroppingViewports,
+        bool flipInY) = 0;
+};
+
+/// The real thing: forwards to a RenderManager, which it owns.
+class RenderManagerBackend : public RenderBackend {
+  public:
+    explicit RenderManagerBackend(RenderManager *render) : render_(render) {}
+
+    bool doingOkay() override { return render_->doingOkay(); }
+
+    RenderManager::OpenResults OpenDisplay() override {
+        return render_->OpenDisplay();
+    }
+
+    void GetRenderInfo(const RenderManager::RenderParams &params,
+                       std::vector<RenderInfo> &renderInfo) override {
+        // RenderManager has no in-place variant and returns a new vector
+        // every time, so this allocates (and frees) once per update event
+        // however @p renderInfo is reserved. Only the copy into it is free.
+        const auto ret = render_->GetRenderInfo(params);
+        renderInfo.assign(ret.begin(), ret.end());
+    }
+
+    bool
+    RegisterRenderBuffers(const std::vector<RenderBuffer> &buffers) override {
+        return render_->RegisterRenderBuffers(buffers);
+    }
+
+    bool PresentRenderBuffers(
+        const std::vector<RenderBuffer> &buffers,
+        const std::vector<RenderInfo> &renderInfoUsed,
+        const RenderManager::RenderParams &renderParams,
+        const std::vector<OSVR_ViewportDescription> &normalizedCroppingViewports,
+        bool flipInY) override {
+        return render_->PresentRenderBuffers(buffers, renderInfoUsed,
+                                             renderParams,
+                                             normalizedCroppingViewports,
+                                             flipInY);
+    }
+
+  private:
+    std::unique_ptr<RenderManager> render_;
+};
+
+/// Drop-in replacement for osvr::renderkit::createRenderManager: wraps the
+/// created RenderManager, or returns the stand-in or trace replay backend if
+/// one has been configured. Returns nullptr on failure.
+RenderBackend *
+createRenderBackend(OSVR_ClientContext context,
+                    const std::string &renderLibraryName,
+                    osvr::renderkit::GraphicsLibrary graphicsLibrary =
+                        osvr::renderkit::GraphicsLibrary());
+
+/// True if createRenderBackend will return a backend that needs no
+/// graphics device (the stand-in or trace replay backend).
+bool usingHeadlessRenderBackend();
+
+#endif // INCLUDED_RenderBackend_h_GUID_8F2D6B04_3E1A_47C9_B5D2_0C7A9E41F638
@@ -0,0 +1,181 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RenderInfoSnapshot_h_GUID_6A1C3E52_0F4B_4D8A_9B27_31E5C0D7A914
+#define INCLUDED_RenderInfoSnapshot_h_GUID_6A1C3E52_0F4B_4D8A_9B27_31E5C0D7A914
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/RenderKit/RenderManager.h>
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// A fixed-capacity copy of the per-eye RenderInfo, published so that
+/// readers (Unity's main thread getters, the render thread) never block the
+/// writer, and the writer never blocks them.
+///
+/// Each publish goes into the next of a small ring of slots, each guarded by
+/// its own sequence number, and only then becomes the latest. A reader copies
+/// the latest complete slot, which the writer leaves alone until it has
+/// published Slots - 1 more times; it never waits for a write in progress,
+/// and retries only if it was lapped that far, at most MaxReadAttempts times.
+///
+/// Writers must be serialized externally: there is at most one publish() in
+/// flight at any time.
+class RenderInfoSnapshot {
+  public:
+    using RenderInfo = osvr::renderkit::RenderInfo;
+
+    /// Most eyes/viewports we keep - enough for multi-viewport displays.
+    static const std::size_t MaxEyes = 8;
+    /// Generations kept at once.
+    static const std::size_t Slots = 4;
+    /// Reads of the latest generation a reader makes before giving up.
+    static const int MaxReadAttempts = 3;
+
+    /// Publish a new set of render info. Entries past MaxEyes are dropped.
+    void publish(const std::vector<RenderInfo> &infos) {
+        const auto generation = latest_.load(std::memory_order_relaxed) + 1;
+        auto &slot = slots_[generation % Slots];
+        // Odd sequence: write in progress.
+        slot.sequence.store(2 * generation - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // Not std::min: it would bind a reference to MaxEyes, which has no
+        // definition outside the class.
+        const auto n = infos.size() < MaxEyes ? infos.size() : MaxEyes;
+        for (std::size_t i = 0; i < n; ++i) {
+            slot.eyes[i] = infos[i];
+        }
+        slot.eyeCount = n;
+
+        slot.sequence.store(2 * generation, std::memory_order_release);
+        latest_.store(generation, std::memory_order_release);
+    }
+
+    /// Copy one eye's info from a consistent snapshot.
+    /// @return false if nothing has been published, the eye is out of range
+    /// or the reader was lapped every attempt (in which case @p out is
+    /// untouched).
+    bool readEye(std::size_t eye, RenderInfo &out) const {
+        bool found = false;
+        RenderInfo copy;
+        const auto generation = read_(
+            [&](const Slot &slot) {
+                found = eye < slot.eyeCount;
+                if (found) {
+                    copy = slot.eyes[eye];
+                }
+            },
+            [&] {
+                if (found) {
+                    out = copy;
+                }
+            });
+        return generation != 0 && found;
+    }
+
+    /// Copy every eye from a consistent snapshot into @p out, reusing its
+    /// storage; @p out is left empty if there is none.
+    /// @return the generation (number of publishes) the copy came from, or 0
+    /// if there was none.
+    std::uint64_t read(std::vector<RenderInfo> &out) const {
+        const auto generation = read_(
+            [&](const Slot &slot) {
+                out.assign(slot.eyes.begin(), slot.eyes.begin() + slot.eyeCount);
+            },
+            [] {});
+        if (generation == 0) {
+            out.clear();
+        }
+        return generation;
+    }
+
+    /// Hand all eyes of a consistent snapshot to @p copy, called as
+    /// copy(const RenderInfo *eyes, std::size_t eyeCount), at most once.
+    /// @return the generation the eyes came from, or 0 if there was none (and
+    /// @p copy was not called).
+    template <typename F> std::uint64_t readAll(F &&copy) const {
+        std::array<RenderInfo, MaxEyes> eyes;
+        std::size_t n = 0;
+        return read_(
+            [&](const Slot &slot) {
+                n = slot.eyeCount;
+                std::copy(slot.eyes.begin(), slot.eyes.begin() + n,
+                          eyes.begin());
+            },
+            [&] { copy(eyes.data(), n); });
+    }
+
+    /// Number of publishes so far; 0 means no render info is available yet.
+    std::uint64_t generation() const {
+        return latest_.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct Slot {
+        /// 2 * the generation held, odd while it is being written.
+        std::atomic<std::uint64_t> sequence{0};
+        std::size_t eyeCount = 0;
+        std::array<RenderInfo, MaxEyes> eyes;
+    };
+
+    /// Run @p copy on the latest complete slot, then @p commit once the copy
+    /// is known to be consistent.
+    template <typename Copy, typename Commit>
+    std::uint64_t read_(Copy &&copy, Commit &&commit) const {
+        for (int attempt = 0; attempt < MaxReadAttempts; ++attempt) {
+            const auto generation = latest_.load(std::memory_order_acquire);
+            if (generation == 0) {
+                return 0;
+            }
+            const auto &slot = slots_[generation % Slots];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * generation) {
+                // Already lapped.
+                continue;
+            }
+            copy(slot);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                commit();
+                return generation;
+            }
+        }
+        return 0;
+    }
+
+    std::atomic<std::uint64_t> latest_{0};
+    std::array<Slot, Slots> slots_;
+};
+
+#endif // INCLUDED_RenderInfoSnapshot_h_GUID_6A1C3E52_0F4B_4D8A_9B27_31E5C0D7A914
@@ -0,0 +1,156 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "StandInRenderBackend.h"
+
+// Library/third-party includes
+#include <osvr/Util/Pose3C.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+StandInRenderBackend::StandInRenderBackend(
+    StandInRenderBackendConfig const &config,
+    osvr::renderkit::GraphicsLibrary library)
+    : config_(config), library_(library), displayOpened_(clock::now()),
+      lastPresent_(displayOpened_) {}
+
+RenderBackend::RenderManager::OpenResults StandInRenderBackend::OpenDisplay() {
+    displayOpened_ = clock::now();
+    lastPresent_ = displayOpened_;
+    RenderManager::OpenResults ret;
+    ret.status = RenderManager::OpenStatus::COMPLETE;
+    ret.library = library_;
+    return ret;
+}
+
+void StandInRenderBackend::GetRenderInfo(
+    const RenderManager::RenderParams &params,
+    std::vector<RenderInfo> &renderInfo) {
+    using seconds = std::chrono::duration<double>;
+    const double t =
+        std::chrono::duration_cast<seconds>(clock::now() - displayOpened_)
+            .count() -
+        config_.trackerLatencySeconds;
+    const double yaw = config_.headYawRate * t;
+
+    // Symmetric 90-degree horizontal field of view at the near plane.
+    const double nearClip = params.nearClipDistanceMeters;
+    const double aspect = config_.viewportHeight / config_.viewportWidth;
+
+    renderInfo.resize(config_.eyeCount);
+    for (std::size_t i = 0; i < renderInfo.size(); ++i) {
+        auto &ri = renderInfo[i];
+        ri.library = library_;
+
+        ri.viewport.left = config_.viewportWidth * static_cast<double>(i);
+        ri.viewport.lower = 0;
+        ri.viewport.width = config_.viewportWidth;
+        ri.viewport.height = config_.viewportHeight;
+
+        ri.projection.left = -nearClip;
+        ri.projection.right = nearClip;
+        ri.projection.bottom = -nearClip * aspect;
+        ri.projection.top = nearClip * aspect;
+        ri.projection.nearClip = nearClip;
+        ri.projection.farClip = params.farClipDistanceMeters;
+
+        // Even eyes to the left, odd eyes to the right, half an IPD out,
+        // rotated with the head about Y.
+        const double offset =
+            (i % 2 == 0 ? -0.5 : 0.5) * params.IPDMeters;
+        osvrVec3SetX(&ri.pose.translation, offset * std::cos(yaw));
+        osvrVec3SetY(&ri.pose.translation, 0);
+        osvrVec3SetZ(&ri.pose.translation, -offset * std::sin(yaw));
+        osvrQuatSetW(&ri.pose.rotation, std::cos(yaw / 2));
+        osvrQuatSetX(&ri.pose.rotation, 0);
+        osvrQuatSetY(&ri.pose.rotation, std::sin(yaw / 2));
+        osvrQuatSetZ(&ri.pose.rotation, 0);
+    }
+}
+
+/// Same native buffer.
+static bool SameBuffer(const RenderBackend::RenderBuffer &a,
+                       const RenderBackend::RenderBuffer &b) {
+    return a.D3D11 == b.D3D11 && a.OpenGL == b.OpenGL;
+}
+
+bool StandInRenderBackend::RegisterRenderBuffers(
+    const std::vector<RenderBuffer> &buffers) {
+    // One buffer per eye, or a swap chain of several per eye.
+    if (buffers.empty() || config_.eyeCount == 0 ||
+        buffers.size() % config_.eyeCount != 0) {
+        return false;
+    }
+    registeredBuffers_ = buffers;
+    return true;
+}
+
+bool StandInRenderBackend::PresentRenderBuffers(
+    const std::vector<RenderBuffer> &buffers,
+    const std::vector<RenderInfo> &renderInfoUsed,
+    const RenderManager::RenderParams & /*renderParams*/,
+    const std::vector<OSVR_ViewportDescription> &normalizedCroppingViewports,
+    bool /*flipInY*/) {
+    if (buffers.size() != config_.eyeCount ||
+        renderInfoUsed.size() != buffers.size() ||
+        (!normalizedCroppingViewports.empty() &&
+         normalizedCroppingViewports.size() != buffers.size())) {
+        return false;
+    }
+    // Each eye's buffer must be one of those registered.
+    for (const auto &buffer : buffers) {
+        if (std::none_of(registeredBuffers_.begin(), registeredBuffers_.end(),
+                         [&](const RenderBuffer &registered) {
+                             return SameBuffer(buffer, registered);
+                         })) {
+            return false;
+        }
+    }
+
+    if (config_.presentObserver) {
+        config_.presentObserver(buffers, true);
+    }
+
+    // Block until the first simulated vsync after the previous one we
+    // presented on, or the next one if we already missed that.
+    const auto interval = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(config_.vsyncIntervalSeconds));
+    auto vsync = lastPresent_ + interval;
+    const auto now = clock::now();
+    if (interval.count() > 0 && now > vsync) {
+        ++missedVsyncs_;
+        vsync += ((now - vsync) / interval + 1) * interval;
+    }
+    std::this_thread::sleep_until(vsync);
+    lastPresent_ = vsync;
+    ++presentedFrames_;
+    if (config_.presentObserver) {
+        config_.presentObserver(buffers, false);
+    }
+    return true;
+}
@@ -0,0 +1,112 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StandInRenderBackend_h_GUID_C4E7A9D3_61B8_4F25_A0E6_9D3B52F1C847
+#define INCLUDED_StandInRenderBackend_h_GUID_C4E7A9D3_61B8_4F25_A0E6_9D3B52F1C847
+
+// Internal Includes
+#include "RenderBackend.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// Settings for the stand-in backend.
+struct StandInRenderBackendConfig {
+    /// Number of eyes/viewports reported by GetRenderInfo.
+    std::size_t eyeCount = 2;
+    /// Simulated display refresh interval: presents block until the next
+    /// multiple of this since the display was opened.
+    double vsyncIntervalSeconds = 1.0 / 90.0;
+    /// Simulated age of each tracker report: poses are evaluated this far in
+    /// the past.
+    double trackerLatencySeconds = 0.0;
+    /// Per-eye viewport size in pixels (defaults match the HDK 1.3).
+    double viewportWidth = 1080.;
+    double viewportHeight = 1200.;
+    /// Yaw rate of the simulated head, in radians per second.
+    double headYawRate = 0.5;
+    /// For tests: called by each valid present with the buffers presented,
+    /// with @p presenting true before its vsync wait and false after.
+    std::function<void(const std::vector<osvr::renderkit::RenderBuffer> &,
+                       bool presenting)>
+        presentObserver;
+};
+
+/// A RenderBackend that needs no HMD, server or GPU: it synthesizes a
+/// slowly turning head pose, symmetric projections and side-by-side
+/// viewports, and paces PresentRenderBuffers to a simulated vsync.
+class StandInRenderBackend : public RenderBackend {
+  public:
+    explicit StandInRenderBackend(StandInRenderBackendConfig const &config,
+                                  osvr::renderkit::GraphicsLibrary library);
+
+    bool doingOkay() override { return true; }
+
+    RenderManager::OpenResults OpenDisplay() override;
+
+    void GetRenderInfo(const RenderManager::RenderParams &params,
+                       std::vector<RenderInfo> &renderInfo) override;
+
+    bool
+    RegisterRenderBuffers(const std::vector<RenderBuffer> &buffers) override;
+
+    bool PresentRenderBuffers(
+        const std::vector<RenderBuffer> &buffers,
+        const std::vector<RenderInfo> &renderInfoUsed,
+        const RenderManager::RenderParams &renderParams,
+        const std::vector<OSVR_ViewportDescription> &normalizedCroppingViewports,
+        bool flipInY) override;
+
+    /// Number of successful presents so far.
+    std::uint64_t presentedFrames() const { return presentedFrames_; }
+
+    /// Number of presents that arrived after the vsync they were aiming for.
+    std::uint64_t missedVsyncs() const { return missedVsyncs_; }
+
+  private:
+    using clock = std::chrono::steady_clock;
+    StandInRenderBackendConfig config_;
+    osvr::renderkit::GraphicsLibrary library_;
+    clock::time_point displayOpened_;
+    clock::time_point lastPresent_;
+    std::vector<RenderBuffer> registeredBuffers_;
+    std::uint64_t presentedFrames_ = 0;
+    std::uint64_t missedVsyncs_ = 0;
+};
+
+/// Make createRenderBackend() return a stand-in backend with this
+/// configuration.
+void useStandInRenderBackend(StandInRenderBackendConfig const &config);
+
+/// Make createRenderBackend() create real RenderManagers again.
+void useRenderManagerBackend();
+
+#endif // INCLUDED_StandInRenderBackend_h_GUID_C4E7A9D3_61B8_4F25_A0E6_9D3B52F1C847
@@ -0,0 +1,221 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "FakeUnityHost.h"
+#include "OsvrRenderingPlugin.h"
+#include "PoseTraceReader.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Replays the render events of a pose trace through the plugin, against the
+/// trace replay backend and with no Unity, HMD or graphics device, then
+/// prints frame time histograms. Build it before and after a change to the
+/// render loop for comparable numbers.
+
+/// Durations in microseconds, bucketed by powers of two.
+class Histogram {
+  public:
+    explicit Histogram(const char *name) : name_(name) {}
+
+    void add(std::int64_t nanoseconds) {
+        samples_.push_back(static_cast<double>(nanoseconds) * 1e-3);
+    }
+
+    void print() {
+        std::printf("\n%s: %zu samples\n", name_, samples_.size());
+        if (samples_.empty()) {
+            return;
+        }
+        std::sort(samples_.begin(), samples_.end());
+        const auto percentile = [&](double p) {
+            return samples_[static_cast<std::size_t>(
+                p * static_cast<double>(samples_.size() - 1))];
+        };
+        std::printf("  p50 %.1f us  p90 %.1f us  p99 %.1f us  max %.1f us\n",
+                    percentile(0.5), percentile(0.9), percentile(0.99),
+                    samples_.back());
+        std::vector<std::size_t> buckets;
+        for (double us : samples_) {
+            std::size_t bucket = 0;
+            for (double edge = 1; us >= edge; edge *= 2) {
+                ++bucket;
+            }
+            if (buckets.size() <= bucket) {
+                buckets.resize(bucket + 1);
+            }
+            ++buckets[bucket];
+        }
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            if (buckets[i] == 0) {
+                continue;
+            }
+            const double low = i == 0 ? 0 : static_cast<double>(1u << (i - 1));
+            const auto bar = buckets[i] * 50 / samples_.size();
+            std::printf("  %8.0f us+ %8zu %s\n", low, buckets[i],
+                        std::string(bar, '#').c_str());
+        }
+    }
+
+  private:
+    const char *name_;
+    std::vector<double> samples_;
+};
+
+struct RecordedEvent {
+    std::int64_t time;
+    int eventID;
+};
+
+int main(int argc, char *argv[]) {
+    bool paced = false;
+    int framesInFlight = 0;
+    const char *path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--paced") == 0) {
+            paced = true;
+        } else if (std::strcmp(argv[i], "--frames-in-flight") == 0 &&
+                   i + 1 < argc) {
+            framesInFlight = std::atoi(argv[++i]);
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        std::fprintf(stderr,
+                     "Usage: %s [--paced] [--frames-in-flight N] <trace>\n"
+                     "  --paced  replay at the recorded event and present "
+                     "times instead of as fast as possible\n",
+                     argv[0]);
+        return 1;
+    }
+
+    PoseTraceReader trace;
+    if (!trace.load(path)) {
+        std::fprintf(stderr, "%s: %s\n", path, trace.error().c_str());
+        return 1;
+    }
+    // Only the events that drive the render loop; the rest need a real
+    // OSVR context or a Unity graphics device.
+    std::vector<RecordedEvent> events;
+    trace.visit([&](const PoseTraceRecordHeader &rh, const char *record) {
+        if (rh.type != kPoseTraceRecord_RenderEvent) {
+            return;
+        }
+        PoseTraceRenderEvent r;
+        PoseTraceReader::read(rh, record, r);
+        if (r.eventID == kOsvrEventID_Render ||
+            r.eventID == kOsvrEventID_Update ||
+            r.eventID == kOsvrEventID_RenderLateLatch) {
+            events.push_back(RecordedEvent{rh.time, r.eventID});
+        }
+    });
+    if (events.empty()) {
+        std::fprintf(stderr, "%s: no render events to replay\n", path);
+        return 1;
+    }
+
+    if (ConfigureTraceReplayBackend(path, paced ? 1 : 0) !=
+        OSVR_RETURN_SUCCESS) {
+        std::fprintf(stderr, "Could not configure the replay backend\n");
+        return 1;
+    }
+    UnityPluginLoad(GetFakeUnityInterfaces());
+    if (CreateRenderManagerFromUnity(nullptr) != OSVR_RETURN_SUCCESS ||
+        ConstructRenderBuffers() != OSVR_RETURN_SUCCESS) {
+        std::fprintf(stderr, "Could not start the plugin on the trace\n");
+        UnityPluginUnload();
+        return 1;
+    }
+    SetAsyncPresent(framesInFlight);
+
+    Histogram frameInterval("Frame interval (present to present)");
+    Histogram renderThread("Render thread time per frame");
+    Histogram presentCall("PresentRenderBuffers call");
+    Histogram eventCall("Render event call");
+    std::vector<OSVR_FrameTiming> timings(256);
+    std::int64_t lastPresent = 0;
+    const auto collect = [&] {
+        int n;
+        while ((n = GetFrameTimings(timings.data(),
+                                    static_cast<int>(timings.size()))) > 0) {
+            for (int i = 0; i < n; ++i) {
+                const auto &t = timings[i];
+                if (lastPresent != 0) {
+                    frameInterval.add(t.presentReturn - lastPresent);
+                }
+                lastPresent = t.presentReturn;
+                renderThread.add(t.renderThreadRelease - t.renderTargetSetup);
+                presentCall.add(t.presentReturn - t.presentSubmit);
+            }
+        }
+    };
+
+    using clock = std::chrono::steady_clock;
+    const auto onRenderEvent = GetRenderEventFunc();
+    const auto start = clock::now();
+    for (const auto &event : events) {
+        if (paced) {
+            std::this_thread::sleep_until(
+                start + std::chrono::duration_cast<clock::duration>(
+                            std::chrono::nanoseconds(event.time -
+                                                     events.front().time)));
+        }
+        const auto before = clock::now();
+        onRenderEvent(event.eventID);
+        eventCall.add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          clock::now() - before)
+                          .count());
+        collect();
+    }
+    // Shutting down presents the frames still in flight, without rendering
+    // one the trace doesn't have.
+    ShutdownRenderManager();
+    collect();
+    const double seconds =
+        std::chrono::duration<double>(clock::now() - start).count();
+    UnityPluginUnload();
+
+    std::printf("Replayed %zu render events from %s in %.3f s (%s)\n",
+                events.size(), path, seconds,
+                paced ? "recorded pacing" : "as fast as possible");
+    std::printf("Frame timings dropped: %llu\n",
+                static_cast<unsigned long long>(GetDroppedFrameTimings()));
+    frameInterval.print();
+    renderThread.print();
+    presentCall.print();
+    eventCall.print();
+    return 0;
+}
@@ -0,0 +1,159 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TraceReplayBackend.h"
+#include "OsvrRenderingPlugin.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <thread>
+
+TraceReplayBackend::TraceReplayBackend(
+    TraceReplayBackendConfig const &config,
+    osvr::renderkit::GraphicsLibrary library)
+    : library_(library), paced_(config.paced) {
+    if (!config.trace) {
+        return;
+    }
+    // Only the GetRenderInfo results of update events are replayed, since
+    // only those are driven by replayed events: each is the run of
+    // RenderInfo records, with one timestamp and eye 0 first, that follows
+    // the update event's record (none if that update fetched nothing).
+    // Results fetched for anything else, such as setting up buffers, are
+    // skipped.
+    std::int64_t frameTime = 0;
+    std::int64_t firstPresent = 0;
+    bool afterUpdate = false;
+    config.trace->visit([&](const PoseTraceRecordHeader &rh,
+                            const char *record) {
+        if (rh.type == kPoseTraceRecord_Present) {
+            if (presentOffsets_.empty()) {
+                firstPresent = rh.time;
+            }
+            presentOffsets_.push_back(rh.time - firstPresent);
+            return;
+        }
+        if (rh.type == kPoseTraceRecord_RenderEvent) {
+            PoseTraceRenderEvent e;
+            PoseTraceReader::read(rh, record, e);
+            afterUpdate = e.eventID == kOsvrEventID_Update;
+            if (afterUpdate) {
+                frames_.emplace_back();
+            }
+            return;
+        }
+        if (rh.type != kPoseTraceRecord_RenderInfo || !afterUpdate) {
+            return;
+        }
+        PoseTraceRenderInfo r;
+        PoseTraceReader::read(rh, record, r);
+        if (frames_.back().empty()) {
+            frameTime = rh.time;
+        } else if (r.eye == 0 || rh.time != frameTime) {
+            // Another GetRenderInfo, not the update's.
+            afterUpdate = false;
+            return;
+        }
+        RenderInfo ri;
+        ri.library = library_;
+        std::copy(r.translation, r.translation + 3, ri.pose.translation.data);
+        std::copy(r.rotation, r.rotation + 4, ri.pose.rotation.data);
+        ri.projection.left = r.projection[0];
+        ri.projection.right = r.projection[1];
+        ri.projection.top = r.projection[2];
+        ri.projection.bottom = r.projection[3];
+        ri.projection.nearClip = r.projection[4];
+        ri.projection.farClip = r.projection[5];
+        ri.viewport.left = r.viewport[0];
+        ri.viewport.lower = r.viewport[1];
+        ri.viewport.width = r.viewport[2];
+        ri.viewport.height = r.viewport[3];
+        frames_.back().push_back(ri);
+    });
+}
+
+RenderBackend::RenderManager::OpenResults TraceReplayBackend::OpenDisplay() {
+    nextFrame_ = 0;
+    registered_ = false;
+    nextPresent_ = 0;
+    RenderManager::OpenResults ret;
+    ret.status = RenderManager::OpenStatus::COMPLETE;
+    ret.library = library_;
+    return ret;
+}
+
+void TraceReplayBackend::GetRenderInfo(
+    const RenderManager::RenderParams & /*params*/,
+    std::vector<RenderInfo> &renderInfo) {
+    if (!registered_) {
+        // Setting up (opening the display, building buffers): show the
+        // first frame with eyes, without using up any recorded update.
+        renderInfo.clear();
+        for (const auto &frame : frames_) {
+            if (!frame.empty()) {
+                renderInfo.assign(frame.begin(), frame.end());
+                break;
+            }
+        }
+        return;
+    }
+    if (frames_.empty()) {
+        renderInfo.clear();
+        return;
+    }
+    const auto frame = std::min(nextFrame_, frames_.size() - 1);
+    ++nextFrame_;
+    renderInfo.assign(frames_[frame].begin(), frames_[frame].end());
+}
+
+bool TraceReplayBackend::RegisterRenderBuffers(
+    const std::vector<RenderBuffer> &buffers) {
+    registered_ = registered_ || !buffers.empty();
+    return !buffers.empty();
+}
+
+bool TraceReplayBackend::PresentRenderBuffers(
+    const std::vector<RenderBuffer> &buffers,
+    const std::vector<RenderInfo> &renderInfoUsed,
+    const RenderManager::RenderParams & /*renderParams*/,
+    const std::vector<OSVR_ViewportDescription> & /*croppingViewports*/,
+    bool /*flipInY*/) {
+    if (buffers.empty() || renderInfoUsed.empty()) {
+        return false;
+    }
+    if (nextPresent_ == 0) {
+        firstPresent_ = clock::now();
+    } else if (paced_ && nextPresent_ < presentOffsets_.size()) {
+        std::this_thread::sleep_until(
+            firstPresent_ +
+            std::chrono::duration_cast<clock::duration>(
+                std::chrono::nanoseconds(presentOffsets_[nextPresent_])));
+    }
+    ++nextPresent_;
+    return true;
+}
@@ -0,0 +1,97 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TraceReplayBackend_h_GUID_B95E2A7C_13D8_4F6B_8C04_7E1F3A9D25C6
+#define INCLUDED_TraceReplayBackend_h_GUID_B95E2A7C_13D8_4F6B_8C04_7E1F3A9D25C6
+
+// Internal Includes
+#include "PoseTraceReader.h"
+#include "RenderBackend.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// Settings for the trace replay backend.
+struct TraceReplayBackendConfig {
+    /// The recorded trace, shared with whatever drives the replay.
+    std::shared_ptr<const PoseTraceReader> trace;
+    /// true: presents return at the recorded present times (relative to the
+    /// first one); false: immediately.
+    bool paced = false;
+};
+
+/// A RenderBackend that plays back a pose trace: once render buffers are
+/// registered, each GetRenderInfo returns what the next recorded update
+/// event fetched, repeating the last one once the trace runs out, and
+/// presents succeed with recorded or no pacing. Before that, GetRenderInfo
+/// returns the first recorded frame, so setting up doesn't shift the replay.
+/// Like the stand-in, it needs no HMD, server or GPU.
+class TraceReplayBackend : public RenderBackend {
+  public:
+    TraceReplayBackend(TraceReplayBackendConfig const &config,
+                       osvr::renderkit::GraphicsLibrary library);
+
+    bool doingOkay() override { return !frames_.empty(); }
+
+    RenderManager::OpenResults OpenDisplay() override;
+
+    void GetRenderInfo(const RenderManager::RenderParams &params,
+                       std::vector<RenderInfo> &renderInfo) override;
+
+    bool
+    RegisterRenderBuffers(const std::vector<RenderBuffer> &buffers) override;
+
+    bool PresentRenderBuffers(
+        const std::vector<RenderBuffer> &buffers,
+        const std::vector<RenderInfo> &renderInfoUsed,
+        const RenderManager::RenderParams &renderParams,
+        const std::vector<OSVR_ViewportDescription> &normalizedCroppingViewports,
+        bool flipInY) override;
+
+  private:
+    using clock = std::chrono::steady_clock;
+    osvr::renderkit::GraphicsLibrary library_;
+    bool paced_;
+    /// What each recorded update event fetched, in order.
+    std::vector<std::vector<RenderInfo>> frames_;
+    std::size_t nextFrame_ = 0;
+    /// Whether render buffers have been registered since OpenDisplay.
+    bool registered_ = false;
+    /// Recorded present times, relative to the first.
+    std::vector<std::int64_t> presentOffsets_;
+    std::size_t nextPresent_ = 0;
+    clock::time_point firstPresent_;
+};
+
+/// Make createRenderBackend() return a trace replay backend with this
+/// configuration.
+void useTraceReplayBackend(TraceReplayBackendConfig const &config);
+
+#endif // INCLUDED_TraceReplayBackend_h_GUID_B95E2A7C_13D8_4F6B_8C04_7E1F3A9D25C6
@@ -0,0 +1,204 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "UnityMatrices.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OSVR_RP_MATRICES_SSE2
+#include <emmintrin.h>
+#else
+#include <cmath>
+#endif
+
+namespace {
+/// Four floats in one SIMD register, with only the operations the kernels
+/// below need. Loads and stores are unaligned: the output buffer is the
+/// caller's.
+#if defined(OSVR_RP_MATRICES_SSE2)
+struct Float4 {
+    __m128 v;
+};
+inline Float4 load(const float *p) { return Float4{_mm_loadu_ps(p)}; }
+inline void store(float *p, Float4 a) { _mm_storeu_ps(p, a.v); }
+inline Float4 splat(float x) { return Float4{_mm_set1_ps(x)}; }
+inline Float4 operator+(Float4 a, Float4 b) {
+    return Float4{_mm_add_ps(a.v, b.v)};
+}
+inline Float4 operator-(Float4 a, Float4 b) {
+    return Float4{_mm_sub_ps(a.v, b.v)};
+}
+inline Float4 operator*(Float4 a, Float4 b) {
+    return Float4{_mm_mul_ps(a.v, b.v)};
+}
+/// 1 / sqrt(a), to full precision (_mm_rsqrt_ps is only good to 12 bits).
+inline Float4 rsqrt(Float4 a) {
+    return Float4{_mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(a.v))};
+}
+inline void transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+    _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+}
+#else
+struct Float4 {
+    float v[4];
+};
+inline Float4 load(const float *p) { return Float4{{p[0], p[1], p[2], p[3]}}; }
+inline void store(float *p, Float4 a) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = a.v[i];
+    }
+}
+inline Float4 splat(float x) { return Float4{{x, x, x, x}}; }
+inline Float4 operator+(Float4 a, Float4 b) {
+    return Float4{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2],
+                   a.v[3] + b.v[3]}};
+}
+inline Float4 operator-(Float4 a, Float4 b) {
+    return Float4{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2],
+                   a.v[3] - b.v[3]}};
+}
+inline Float4 operator*(Float4 a, Float4 b) {
+    return Float4{{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2],
+                   a.v[3] * b.v[3]}};
+}
+inline Float4 rsqrt(Float4 a) {
+    for (int i = 0; i < 4; ++i) {
+        a.v[i] = 1.f / std::sqrt(a.v[i]);
+    }
+    return a;
+}
+inline void transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+    Float4 *rows[4] = {&a, &b, &c, &d};
+    for (int i = 0; i < 4; ++i) {
+        for (int j = i + 1; j < 4; ++j) {
+            const float t = rows[i]->v[j];
+            rows[i]->v[j] = rows[j]->v[i];
+            rows[j]->v[i] = t;
+        }
+    }
+}
+#endif
+
+/// out = a * b, all column-major.
+inline void multiply(const float *a, const float *b, float *out) {
+    const Float4 a0 = load(a);
+    const Float4 a1 = load(a + 4);
+    const Float4 a2 = load(a + 8);
+    const Float4 a3 = load(a + 12);
+    for (int j = 0; j < 4; ++j) {
+        const float *bj = b + 4 * j;
+        store(out + 4 * j, a0 * splat(bj[0]) + a1 * splat(bj[1]) +
+                               a2 * splat(bj[2]) + a3 * splat(bj[3]));
+    }
+}
+
+/// Scale four planes (x, y, z, distance) to unit normals and store them.
+inline void normalizePlanes(Float4 a, Float4 b, Float4 c, Float4 d,
+                            float (*out)[4], int count) {
+    transpose(a, b, c, d);
+    const Float4 inverseLength = rsqrt(a * a + b * b + c * c);
+    a = a * inverseLength;
+    b = b * inverseLength;
+    c = c * inverseLength;
+    d = d * inverseLength;
+    transpose(a, b, c, d);
+    const Float4 planes[4] = {a, b, c, d};
+    for (int i = 0; i < count; ++i) {
+        store(out[i], planes[i]);
+    }
+}
+
+/// Unity's frustum planes (GeometryUtility.CalculateFrustumPlanes order and
+/// sign: left, right, bottom, top, near, far, normals pointing inwards) from
+/// a view-projection matrix, by the Gribb-Hartmann method.
+inline void extractFrustumPlanes(const float *viewProjection,
+                                 float (*planes)[4]) {
+    // Transposing the columns gives the rows.
+    Float4 r0 = load(viewProjection);
+    Float4 r1 = load(viewProjection + 4);
+    Float4 r2 = load(viewProjection + 8);
+    Float4 r3 = load(viewProjection + 12);
+    transpose(r0, r1, r2, r3);
+    const Float4 nearPlane = r3 + r2;
+    const Float4 farPlane = r3 - r2;
+    normalizePlanes(r3 + r0, r3 - r0, r3 + r1, r3 - r1, planes, 4);
+    normalizePlanes(nearPlane, farPlane, nearPlane, farPlane, planes + 4, 2);
+}
+
+/// Negate row 1 (clip-space Y) of a column-major matrix.
+inline void flipClipY(float *m) {
+    static const float sign[4] = {1.f, -1.f, 1.f, 1.f};
+    const Float4 s = load(sign);
+    for (int j = 0; j < 4; ++j) {
+        store(m + 4 * j, load(m + 4 * j) * s);
+    }
+}
+
+inline void setIdentity(double *m) {
+    for (int i = 0; i < 16; ++i) {
+        m[i] = i % 5 == 0 ? 1. : 0.;
+    }
+}
+} // namespace
+
+void ComputeUnityEyeMatrices(const OSVR_PoseState *poses,
+                             const osvr::renderkit::OSVR_ProjectionMatrix *
+                                 projections,
+                             std::size_t eyeCount, bool flipY,
+                             OSVR_EyeMatrices *out) {
+    for (std::size_t eye = 0; eye < eyeCount; ++eye) {
+        double view[16];
+        double projection[16];
+        if (!osvr::renderkit::OSVR_PoseState_to_OpenGL(view, poses[eye])) {
+            setIdentity(view);
+        }
+        if (!osvr::renderkit::OSVR_Projection_to_OpenGL(projection,
+                                                        projections[eye])) {
+            setIdentity(projection);
+        }
+        // Unity's world is OSVR's room mirrored in Z; applying that mirror
+        // before the room-to-eye transform negates the view's Z column.
+        auto &m = out[eye];
+        for (int i = 0; i < 16; ++i) {
+            m.view[i] = static_cast<float>(i / 4 == 2 ? -view[i] : view[i]);
+            m.projection[i] = static_cast<float>(projection[i]);
+        }
+    }
+    for (std::size_t eye = 0; eye < eyeCount; ++eye) {
+        auto &m = out[eye];
+        multiply(m.projection, m.view, m.viewProjection);
+        // Planes come from the unflipped matrix, so they stay in Unity's
+        // convention either way.
+        extractFrustumPlanes(m.viewProjection, m.frustumPlanes);
+        if (flipY) {
+            flipClipY(m.projection);
+            flipClipY(m.viewProjection);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_UnityMatrices_h_GUID_E3A85C21_4F07_4B9D_96C8_2D71B0F4A6E9
+#define INCLUDED_UnityMatrices_h_GUID_E3A85C21_4F07_4B9D_96C8_2D71B0F4A6E9
+
+// Internal Includes
+#include "OsvrRenderingPlugin.h"
+
+// Library/third-party includes
+#include <osvr/RenderKit/RenderKitGraphicsTransforms.h>
+
+// Standard includes
+#include <cstddef>
+
+/// Converts OSVR eye poses and projections into the matrices Unity uses, for
+/// GetFrameMatrices.
+///
+/// Each eye's pose and projection go through RenderKit's OpenGL transform
+/// helpers (right-handed, column-major, clip Z in [-1, 1]) - the convention
+/// Unity's Camera.worldToCameraMatrix and Camera.projectionMatrix already
+/// use. What remains is mirroring Unity's left-handed world into OSVR's
+/// right-handed room, the view-projection product and the frustum planes,
+/// which run on four floats at a time (SSE2 or plain C++).
+///
+/// @param flipY negate clip-space Y in the projection and view-projection
+/// matrices, for rendering upside-down into Direct3D render textures.
+void ComputeUnityEyeMatrices(const OSVR_PoseState *poses,
+                             const osvr::renderkit::OSVR_ProjectionMatrix *
+                                 projections,
+                             std::size_t eyeCount, bool flipY,
+                             OSVR_EyeMatrices *out);
+
+#endif // INCLUDED_UnityMatrices_h_GUID_E3A85C21_4F07_4B9D_96C8_2D71B0F4A6E9
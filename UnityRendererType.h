@@ -38,6 +38,9 @@
 /// avoids spurious "unhandled cases in switch" warnings".
 enum class OSVRSupportedRenderers {
     EmptyRenderer,
+    /// No graphics device: for the headless render backends, which take
+    /// buffers without textures.
+    Headless,
 #if SUPPORT_D3D11
     D3D11,
 #endif
@@ -91,6 +94,12 @@ class UnityRendererType {
         return *this;
     }
 
+    /// Run without a graphics device, see OSVRSupportedRenderers::Headless.
+    void setHeadless() {
+        renderer_ = OSVRSupportedRenderers::Headless;
+        supported_ = true;
+    }
+
     void reset() {
         renderer_ = OSVRSupportedRenderers::EmptyRenderer;
         supported_ = false;
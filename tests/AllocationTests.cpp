@@ -0,0 +1,116 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "FakeUnityHost.h"
+#include "OsvrRenderingPlugin.h"
+#include "TestHarness.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/// The plugin's own per-frame path must not touch the heap once it has
+/// warmed up: every operator new in this program is counted, and the
+/// steady-state frames of each present mode must leave the count unchanged.
+///
+/// This runs on the stand-in backend only, so it says nothing about
+/// RenderManager itself: its GetRenderInfo returns a new vector on every
+/// update event (see RenderManagerBackend), and whatever its
+/// PresentRenderBuffers allocates is not counted.
+
+static std::atomic<std::size_t> s_allocations{0};
+
+void *operator new(std::size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size != 0 ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete[](void *p) noexcept { operator delete(p); }
+
+static const int WarmUpFrames = 100;
+static const int SteadyStateFrames = 10000;
+
+/// Run @p frames frames of @p renderEvent and return how many allocations
+/// they made.
+static std::size_t CountFrameAllocations(int frames, int renderEvent) {
+    const auto onRenderEvent = GetRenderEventFunc();
+    OSVR_FrameTiming timings[16];
+    const auto before = s_allocations.load();
+    for (int i = 0; i < frames; ++i) {
+        onRenderEvent(kOsvrEventID_Update);
+        onRenderEvent(renderEvent);
+        // Polling the timings is part of a game's frame too.
+        GetFrameTimings(timings, 16);
+    }
+    return s_allocations.load() - before;
+}
+
+static void CheckSteadyState(int framesInFlight, int renderEvent) {
+    StandInRenderBackendConfig config;
+    config.vsyncIntervalSeconds = 0;
+    CHECK(StartHeadlessPlugin(config));
+    SetAsyncPresent(framesInFlight);
+    CountFrameAllocations(WarmUpFrames, renderEvent);
+    CHECK(CountFrameAllocations(SteadyStateFrames, renderEvent) == 0);
+    StopHeadlessPlugin();
+    SetAsyncPresent(0);
+}
+
+static void TestSynchronousPresent() {
+    CheckSteadyState(0, kOsvrEventID_Render);
+}
+
+static void TestLateLatch() {
+    CheckSteadyState(0, kOsvrEventID_RenderLateLatch);
+}
+
+static void TestAsyncPresent() { CheckSteadyState(2, kOsvrEventID_Render); }
+
+static void TestDynamicResolution() {
+    // Scaled cropping viewports are built per frame.
+    SetDynamicResolution(1, 0.5, 0.0001);
+    CheckSteadyState(0, kOsvrEventID_Render);
+    SetDynamicResolution(0, 0, 0);
+}
+
+int main() {
+    RUN_TEST(TestSynchronousPresent);
+    RUN_TEST(TestLateLatch);
+    RUN_TEST(TestAsyncPresent);
+    RUN_TEST(TestDynamicResolution);
+    return TestExitStatus();
+}
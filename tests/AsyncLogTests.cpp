@@ -0,0 +1,205 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncLog.h"
+#include "TestHarness.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// AsyncLog on its own: what a full queue does, the order records come out
+/// in, and several producers racing a drain thread.
+
+/// Collects what an AsyncLog delivers, from whichever thread delivers it.
+struct Delivered {
+    std::mutex mutex;
+    std::vector<std::string> texts;
+    int syncs = 0;
+    /// Records delivered when sync was last called.
+    std::size_t syncedCount = 0;
+
+    AsyncLog::DeliverFunction deliver() {
+        return [this](const LogRecord &record) {
+            std::lock_guard<std::mutex> lock(mutex);
+            texts.push_back(record.text);
+        };
+    }
+    AsyncLog::SyncFunction sync() {
+        return [this] {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++syncs;
+            syncedCount = texts.size();
+        };
+    }
+};
+
+static std::string Numbered(int producer, int n) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%d:%d", producer, n);
+    return text;
+}
+
+static void TestDropsWhenFull() {
+    Delivered delivered;
+    AsyncLog log(delivered.deliver());
+    for (int i = 0; i < static_cast<int>(AsyncLog::Capacity); ++i) {
+        CHECK(log.push(LogLevel::Info, Numbered(0, i).c_str()));
+    }
+    CHECK(!log.push(LogLevel::Info, "dropped"));
+    CHECK(!log.push(LogLevel::Error, "dropped too"));
+    CHECK(log.dropped() == 2);
+
+    CHECK(log.flush() == AsyncLog::Capacity);
+    CHECK(delivered.texts.size() == AsyncLog::Capacity);
+    CHECK(delivered.texts.back() ==
+          Numbered(0, static_cast<int>(AsyncLog::Capacity) - 1));
+
+    // Room again once drained.
+    CHECK(log.push(LogLevel::Info, "after"));
+    CHECK(log.flush() == 1);
+    CHECK(delivered.texts.back() == "after");
+    CHECK(log.dropped() == 2);
+}
+
+static void TestDeliversInOrder() {
+    Delivered delivered;
+    AsyncLog log(delivered.deliver());
+    // Several laps of the queue, flushed at odd points.
+    const int records = 5 * static_cast<int>(AsyncLog::Capacity) + 7;
+    for (int i = 0; i < records; ++i) {
+        CHECK(log.push(LogLevel::Debug, Numbered(0, i).c_str()));
+        if (i % 97 == 0) {
+            log.flush();
+        }
+    }
+    log.flush();
+    CHECK(delivered.texts.size() == static_cast<std::size_t>(records));
+    bool inOrder = true;
+    for (int i = 0; i < records && i < static_cast<int>(delivered.texts.size());
+         ++i) {
+        inOrder = inOrder && delivered.texts[i] == Numbered(0, i);
+    }
+    CHECK(inOrder);
+}
+
+static void TestTruncatesLongRecords() {
+    Delivered delivered;
+    AsyncLog log(delivered.deliver());
+    const std::string text(LogRecord::MaxLength + 50, 'x');
+    CHECK(log.push(LogLevel::Warning, text.c_str()));
+    CHECK(log.push(LogLevel::Warning, nullptr));
+    log.flush();
+    CHECK(delivered.texts.size() == 2);
+    if (delivered.texts.size() == 2) {
+        CHECK(delivered.texts[0] == text.substr(0, LogRecord::MaxLength));
+        CHECK(delivered.texts[1].empty());
+    }
+}
+
+static void TestSyncFollowsDelivery() {
+    Delivered delivered;
+    AsyncLog log(delivered.deliver(), delivered.sync());
+    log.push(LogLevel::Info, "a");
+    log.flush();
+    CHECK(delivered.syncs == 0);
+    log.push(LogLevel::Info, "b");
+    log.flush(true);
+    CHECK(delivered.syncs == 1);
+    CHECK(delivered.syncedCount == 2);
+    // Stopping the drain thread syncs what it delivered last.
+    log.startDrainThread(std::chrono::milliseconds(1000));
+    log.push(LogLevel::Info, "c");
+    log.stopDrainThread();
+    CHECK(delivered.syncs == 2);
+    CHECK(delivered.syncedCount == 3);
+}
+
+static void TestManyProducersWithDrainThread() {
+    const int producers = 4;
+    const int perProducer = 5000;
+    Delivered delivered;
+    AsyncLog log(delivered.deliver());
+    log.startDrainThread(std::chrono::milliseconds(1));
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&log, p] {
+            for (int i = 0; i < perProducer; ++i) {
+                log.push(LogLevel::Info, Numbered(p, i).c_str());
+                // Mostly slower than the drain thread, with bursts that
+                // fill the queue.
+                if (i % 16 == 0) {
+                    std::this_thread::sleep_for(
+                        std::chrono::microseconds(100));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    log.stopDrainThread();
+
+    std::printf("%d producers: %zu delivered, %llu dropped\n", producers,
+                delivered.texts.size(),
+                static_cast<unsigned long long>(log.dropped()));
+    // Nothing lost or duplicated, and each producer's records in its order.
+    CHECK(delivered.texts.size() + log.dropped() ==
+          static_cast<std::size_t>(producers * perProducer));
+    std::vector<int> last(producers, -1);
+    bool wellFormed = true;
+    bool inOrder = true;
+    for (const auto &text : delivered.texts) {
+        const char *colon = std::strchr(text.c_str(), ':');
+        const int p = std::atoi(text.c_str());
+        if (colon == nullptr || p < 0 || p >= producers) {
+            wellFormed = false;
+            continue;
+        }
+        const int n = std::atoi(colon + 1);
+        inOrder = inOrder && n > last[p];
+        last[p] = n;
+    }
+    CHECK(wellFormed);
+    CHECK(inOrder);
+}
+
+int main() {
+    RUN_TEST(TestDropsWhenFull);
+    RUN_TEST(TestDeliversInOrder);
+    RUN_TEST(TestTruncatesLongRecords);
+    RUN_TEST(TestSyncFollowsDelivery);
+    RUN_TEST(TestManyProducersWithDrainThread);
+    return TestExitStatus();
+}
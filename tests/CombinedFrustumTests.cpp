@@ -0,0 +1,186 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "CombinedFrustum.h"
+#include "TestHarness.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstdio>
+
+/// ComputeCombinedFrustum on a synthetic HMD: two eyes 64 mm apart, each
+/// with an outward-asymmetric projection, parallel or canted outwards.
+
+static const double Ipd = 0.064;
+
+/// Eye @p eye (0 left, 1 right) at head height, turned outwards about +Y
+/// by @p cant radians.
+static OSVR_PoseState EyePose(int eye, double cant) {
+    const double side = eye == 0 ? -1 : 1;
+    // Turning the right eye outwards (towards +X) is a negative rotation.
+    const double angle = -side * cant;
+    OSVR_PoseState pose = {};
+    pose.translation.data[0] = side * Ipd / 2;
+    pose.translation.data[1] = 1.7;
+    pose.rotation.data[0] = std::cos(angle / 2);
+    pose.rotation.data[2] = std::sin(angle / 2);
+    return pose;
+}
+
+/// Wider on the outer side, as HMD lenses are.
+static osvr::renderkit::OSVR_ProjectionMatrix EyeProjection(int eye) {
+    const double inner = 1.1, outer = 1.3;
+    osvr::renderkit::OSVR_ProjectionMatrix p = {};
+    p.nearClip = 0.1;
+    p.farClip = 100;
+    p.left = -(eye == 0 ? outer : inner) * p.nearClip;
+    p.right = (eye == 0 ? inner : outer) * p.nearClip;
+    p.bottom = -1.1 * p.nearClip;
+    p.top = 1.1 * p.nearClip;
+    return p;
+}
+
+struct Vec {
+    double x, y, z;
+};
+
+/// Rotate @p v by @p pose's rotation.
+static Vec Rotate(const OSVR_PoseState &pose, Vec v, bool inverse = false) {
+    const double w = pose.rotation.data[0];
+    const double s = inverse ? -1 : 1;
+    const double qx = s * pose.rotation.data[1];
+    const double qy = s * pose.rotation.data[2];
+    const double qz = s * pose.rotation.data[3];
+    // v + 2w (q x v) + 2 q x (q x v)
+    const Vec t = {2 * (qy * v.z - qz * v.y), 2 * (qz * v.x - qx * v.z),
+                   2 * (qx * v.y - qy * v.x)};
+    return {v.x + w * t.x + qy * t.z - qz * t.y,
+            v.y + w * t.y + qz * t.x - qx * t.z,
+            v.z + w * t.z + qx * t.y - qy * t.x};
+}
+
+/// Whether every corner of each eye's frustum lies inside @p combined.
+static bool EnclosesEyes(const CombinedFrustum &combined,
+                         const OSVR_PoseState *poses,
+                         const osvr::renderkit::OSVR_ProjectionMatrix *
+                             projections,
+                         int eyeCount) {
+    const double slack = 1e-9;
+    const auto &c = combined.projection;
+    for (int i = 0; i < eyeCount; ++i) {
+        const auto &p = projections[i];
+        for (double depth : {p.nearClip, p.farClip}) {
+            const double scale = depth / p.nearClip;
+            for (double x : {p.left, p.right}) {
+                for (double y : {p.bottom, p.top}) {
+                    const Vec local =
+                        Rotate(poses[i], {x * scale, y * scale, -depth});
+                    const Vec offset = {
+                        poses[i].translation.data[0] + local.x -
+                            combined.pose.translation.data[0],
+                        poses[i].translation.data[1] + local.y -
+                            combined.pose.translation.data[1],
+                        poses[i].translation.data[2] + local.z -
+                            combined.pose.translation.data[2]};
+                    const Vec v = Rotate(combined.pose, offset, true);
+                    const double d = -v.z;
+                    if (d < c.nearClip * (1 - slack) ||
+                        d > c.farClip * (1 + slack) ||
+                        v.x / d < c.left / c.nearClip - slack ||
+                        v.x / d > c.right / c.nearClip + slack ||
+                        v.y / d < c.bottom / c.nearClip - slack ||
+                        v.y / d > c.top / c.nearClip + slack) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/// Combined frustum of the two eyes canted by @p cant, with eye volume.
+static bool Combine(double cant, CombinedFrustum &combined) {
+    const OSVR_PoseState poses[2] = {EyePose(0, cant), EyePose(1, cant)};
+    const osvr::renderkit::OSVR_ProjectionMatrix projections[2] = {
+        EyeProjection(0), EyeProjection(1)};
+    if (!ComputeCombinedFrustum(poses, projections, 2, true, combined)) {
+        return false;
+    }
+    std::printf("cant %.2f rad: %.1f m^3 combined, %.1f m^3 seen by the "
+                "eyes, %.1f%% extra\n",
+                cant, combined.volume, combined.eyeVolume,
+                100 * (combined.volume - combined.eyeVolume) /
+                    combined.eyeVolume);
+    CHECK(EnclosesEyes(combined, poses, projections, 2));
+    return true;
+}
+
+static double ExtraFraction(const CombinedFrustum &combined) {
+    return (combined.volume - combined.eyeVolume) / combined.eyeVolume;
+}
+
+static void TestParallelEyesAddAlmostNothing() {
+    CombinedFrustum combined;
+    CHECK(Combine(0, combined));
+    CHECK(combined.eyeVolume > 0);
+    CHECK(ExtraFraction(combined) < 0.01);
+    // Looking down -Z like the eyes, between and behind them.
+    CHECK(std::fabs(combined.pose.rotation.data[0] - 1) < 1e-12);
+    CHECK(std::fabs(combined.pose.translation.data[0]) < 1e-12);
+    CHECK(combined.pose.translation.data[2] > 0);
+}
+
+static void TestCantedEyesStayEnclosed() {
+    // Canting pulls the far corners apart, so the combined frustum takes in
+    // a wedge between the eyes that neither sees: about 41% more here.
+    CombinedFrustum combined;
+    CHECK(Combine(0.1, combined));
+    const double extra = ExtraFraction(combined);
+    CHECK(extra > 0.38 && extra < 0.44);
+}
+
+static void TestRejectsUnusableInput() {
+    CombinedFrustum combined;
+    const OSVR_PoseState poses[2] = {EyePose(0, 0), EyePose(1, 0)};
+    osvr::renderkit::OSVR_ProjectionMatrix projections[2] = {
+        EyeProjection(0), EyeProjection(1)};
+    CHECK(!ComputeCombinedFrustum(poses, projections, 0, false, combined));
+    projections[1].farClip = projections[1].nearClip;
+    CHECK(!ComputeCombinedFrustum(poses, projections, 2, false, combined));
+    projections[1] = EyeProjection(1);
+    CHECK(ComputeCombinedFrustum(poses, projections, 2, false, combined));
+    CHECK(combined.eyeVolume < 0);
+}
+
+int main() {
+    RUN_TEST(TestParallelEyesAddAlmostNothing);
+    RUN_TEST(TestCantedEyesStayEnclosed);
+    RUN_TEST(TestRejectsUnusableInput);
+    return TestExitStatus();
+}
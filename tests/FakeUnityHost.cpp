@@ -0,0 +1,102 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "FakeUnityHost.h"
+#include "OsvrRenderingPlugin.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+static IUnityGraphicsDeviceEventCallback s_deviceEventCallback = nullptr;
+
+static UnityGfxRenderer UNITY_INTERFACE_API GetRenderer() {
+    return kUnityGfxRendererNull;
+}
+
+static void UNITY_INTERFACE_API
+RegisterDeviceEventCallback(IUnityGraphicsDeviceEventCallback callback) {
+    s_deviceEventCallback = callback;
+}
+
+static void UNITY_INTERFACE_API
+UnregisterDeviceEventCallback(IUnityGraphicsDeviceEventCallback callback) {
+    if (s_deviceEventCallback == callback) {
+        s_deviceEventCallback = nullptr;
+    }
+}
+
+static IUnityGraphics s_graphics;
+
+static IUnityInterface *UNITY_INTERFACE_API
+GetInterface(UnityInterfaceGUID guid) {
+    if (guid == GetUnityInterfaceGUID<IUnityGraphics>()) {
+        return &s_graphics;
+    }
+    return nullptr;
+}
+
+static void UNITY_INTERFACE_API RegisterInterface(UnityInterfaceGUID,
+                                                  IUnityInterface *) {}
+
+static IUnityInterfaces s_interfaces;
+
+IUnityInterfaces *GetFakeUnityInterfaces() {
+    // UNITY_DECLARE_INTERFACE makes these non-aggregates.
+    s_graphics.GetRenderer = GetRenderer;
+    s_graphics.RegisterDeviceEventCallback = RegisterDeviceEventCallback;
+    s_graphics.UnregisterDeviceEventCallback = UnregisterDeviceEventCallback;
+    s_interfaces.GetInterface = GetInterface;
+    s_interfaces.RegisterInterface = RegisterInterface;
+    return &s_interfaces;
+}
+
+void SendFakeDeviceEvent(UnityGfxDeviceEventType eventType) {
+    if (s_deviceEventCallback != nullptr) {
+        s_deviceEventCallback(eventType);
+    }
+}
+
+bool StartHeadlessPlugin(StandInRenderBackendConfig const &config) {
+    useStandInRenderBackend(config);
+    UnityPluginLoad(GetFakeUnityInterfaces());
+    if (CreateRenderManagerFromUnity(nullptr) != OSVR_RETURN_SUCCESS ||
+        ConstructRenderBuffers() != OSVR_RETURN_SUCCESS) {
+        StopHeadlessPlugin();
+        return false;
+    }
+    return true;
+}
+
+void StopHeadlessPlugin() {
+    // As a game would, in case the present thread is running.
+    GetRenderEventFunc()(kOsvrEventID_Shutdown);
+    ShutdownRenderManager();
+    UnityPluginUnload();
+    useRenderManagerBackend();
+}
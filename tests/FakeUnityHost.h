@@ -0,0 +1,60 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_FakeUnityHost_h_GUID_3D81F6A2_5C07_4B9E_A214_E86B07C59D31
+#define INCLUDED_FakeUnityHost_h_GUID_3D81F6A2_5C07_4B9E_A214_E86B07C59D31
+
+// Internal Includes
+#include "StandInRenderBackend.h"
+#include "Unity/IUnityGraphics.h"
+#include "Unity/IUnityInterface.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+/// A Unity host with no graphics device, for running the plugin outside of
+/// Unity: its IUnityGraphics reports kUnityGfxRendererNull, so the plugin
+/// runs headless on the stand-in or trace replay backend, and the device
+/// event callback the plugin registers is kept for SendFakeDeviceEvent.
+IUnityInterfaces *GetFakeUnityInterfaces();
+
+/// Deliver a graphics device event the way Unity would (on a device reset,
+/// for instance). Does nothing unless the plugin is loaded.
+void SendFakeDeviceEvent(UnityGfxDeviceEventType eventType);
+
+/// Load the plugin into the fake host on a stand-in backend with
+/// @p config, then create RenderManager and its buffers as a game would.
+/// @return false (with the plugin unloaded again) if any step failed.
+bool StartHeadlessPlugin(StandInRenderBackendConfig const &config);
+
+/// Stop the present thread with a render event on the calling thread, shut
+/// RenderManager down and unload the plugin, leaving the backend selection
+/// as it was before StartHeadlessPlugin.
+void StopHeadlessPlugin();
+
+#endif // INCLUDED_FakeUnityHost_h_GUID_3D81F6A2_5C07_4B9E_A214_E86B07C59D31
@@ -0,0 +1,556 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "FakeUnityHost.h"
+#include "OsvrRenderingPlugin.h"
+#include "TestHarness.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// The full plugin lifecycle, as a game drives it, on the stand-in backend
+/// in the fake Unity host: no HMD, OSVR server or GPU needed.
+
+static StandInRenderBackendConfig Unpaced(std::size_t eyeCount) {
+    StandInRenderBackendConfig config;
+    config.eyeCount = eyeCount;
+    config.vsyncIntervalSeconds = 0;
+    return config;
+}
+
+/// Update and render @p frames frames, as Unity's render thread would.
+static void RenderFrames(int frames) {
+    const auto onRenderEvent = GetRenderEventFunc();
+    for (int i = 0; i < frames; ++i) {
+        onRenderEvent(kOsvrEventID_Update);
+        onRenderEvent(kOsvrEventID_Render);
+    }
+}
+
+/// Warnings and errors the plugin logged since the last call. The log drain
+/// thread delivers them too, hence the mutex.
+static std::mutex s_loggedMutex;
+static std::vector<std::string> s_logged;
+static void UNITY_INTERFACE_API Logged(const char *message) {
+    std::lock_guard<std::mutex> lock(s_loggedMutex);
+    s_logged.push_back(message);
+}
+static std::vector<std::string> TakeLogged() {
+    FlushLog();
+    std::vector<std::string> logged;
+    std::lock_guard<std::mutex> lock(s_loggedMutex);
+    logged.swap(s_logged);
+    return logged;
+}
+static bool PresentFailed(const std::vector<std::string> &logged) {
+    for (const auto &message : logged) {
+        if (message.find("PresentRenderBuffers() returned false") !=
+            std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Pop every queued frame timing.
+static std::vector<OSVR_FrameTiming> TakeFrameTimings() {
+    std::vector<OSVR_FrameTiming> timings;
+    OSVR_FrameTiming buffer[64];
+    int n;
+    while ((n = GetFrameTimings(buffer, 64)) > 0) {
+        timings.insert(timings.end(), buffer, buffer + n);
+    }
+    return timings;
+}
+
+static void TestLifecycle() {
+    TakeFrameTimings();
+    LinkDebug(Logged);
+    CHECK(StartHeadlessPlugin(Unpaced(2)));
+    CHECK(GetRenderManagerStatus() == kOsvrRenderManagerStatus_Ready);
+    CHECK(GetViewport(1).width == 1080.);
+    CHECK(GetViewport(1).left == 1080.);
+
+    RenderFrames(100);
+    const auto timings = TakeFrameTimings();
+    CHECK(timings.size() == 100);
+    for (std::size_t i = 1; i < timings.size(); ++i) {
+        CHECK(timings[i].frame == timings[i - 1].frame + 1);
+        CHECK(timings[i].presentReturn >= timings[i].presentSubmit);
+        CHECK(timings[i].poseFetch != 0);
+    }
+
+    OSVR_FrameState state;
+    CHECK(GetFrameState(&state) == OSVR_RETURN_SUCCESS);
+    CHECK(state.eyeCount == 2);
+    CHECK(!PresentFailed(TakeLogged()));
+    StopHeadlessPlugin();
+    LinkDebug(nullptr);
+    CHECK(GetRenderManagerStatus() == kOsvrRenderManagerStatus_None);
+}
+
+static void TestEyeCounts() {
+    for (std::size_t eyes : {1, 4, 8}) {
+        TakeFrameTimings();
+        CHECK(StartHeadlessPlugin(Unpaced(eyes)));
+        RenderFrames(10);
+        CHECK(TakeFrameTimings().size() == 10);
+        OSVR_FrameState state;
+        CHECK(GetFrameState(&state) == OSVR_RETURN_SUCCESS);
+        CHECK(state.eyeCount == static_cast<int32_t>(eyes));
+        StopHeadlessPlugin();
+    }
+}
+
+static void TestVsyncPacing() {
+    auto config = Unpaced(2);
+    config.vsyncIntervalSeconds = 0.002;
+    CHECK(StartHeadlessPlugin(config));
+    const auto start = std::chrono::steady_clock::now();
+    RenderFrames(50);
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    // Presents return on simulated vsyncs, so 50 frames take at least 49
+    // intervals (the first may come right away).
+    CHECK(seconds >= 49 * config.vsyncIntervalSeconds);
+    StopHeadlessPlugin();
+}
+
+static void TestSwapChain() {
+    const int length = 3;
+    SetEyeBufferCount(length);
+    LinkDebug(Logged);
+    CHECK(StartHeadlessPlugin(Unpaced(2)));
+    TakeLogged();
+    const auto onRenderEvent = GetRenderEventFunc();
+    for (int frame = 0; frame < 2 * length; ++frame) {
+        for (int eye = 0; eye < 2; ++eye) {
+            CHECK(AcquireEyeBuffer(eye) == frame % length);
+        }
+        onRenderEvent(kOsvrEventID_Update);
+        onRenderEvent(kOsvrEventID_Render);
+    }
+    CHECK(!PresentFailed(TakeLogged()));
+    StopHeadlessPlugin();
+    LinkDebug(nullptr);
+    SetEyeBufferCount(0);
+}
+
+/// Unity's main thread acquiring swap chain buffers while the render thread
+/// updates and presents, with and without frames in flight: no buffer may be
+/// handed out while it is being presented.
+static void TestSwapChainAcrossThreads() {
+    for (int framesInFlight : {0, 2}) {
+        const int length = framesInFlight + 2;
+        // Taken around each acquire and its check, and around each update,
+        // so an update can't lock in a buffer between the two.
+        std::mutex unityMutex;
+        std::mutex presentingMutex;
+        std::vector<void *> presenting;
+        auto config = Unpaced(2);
+        config.vsyncIntervalSeconds = 0.001;
+        config.presentObserver =
+            [&](const std::vector<osvr::renderkit::RenderBuffer> &buffers,
+                bool now) {
+                std::lock_guard<std::mutex> lock(presentingMutex);
+                presenting.clear();
+                for (const auto &buffer : buffers) {
+                    if (now) {
+                        presenting.push_back(buffer.OpenGL);
+                    }
+                }
+            };
+        SetEyeBufferCount(length);
+        SetAsyncPresent(framesInFlight);
+        LinkDebug(Logged);
+        CHECK(StartHeadlessPlugin(config));
+        TakeLogged();
+        TakeFrameTimings();
+
+        const int frames = 100;
+        std::atomic<bool> done{false};
+        std::thread renderThread([&] {
+            const auto onRenderEvent = GetRenderEventFunc();
+            for (int i = 0; i < frames; ++i) {
+                {
+                    std::lock_guard<std::mutex> lock(unityMutex);
+                    onRenderEvent(kOsvrEventID_Update);
+                }
+                onRenderEvent(kOsvrEventID_Render);
+            }
+            done = true;
+        });
+        int acquired = 0;
+        int handedOutWhilePresenting = 0;
+        while (!done) {
+            for (int eye = 0; eye < 2; ++eye) {
+                std::lock_guard<std::mutex> lock(unityMutex);
+                const int index = AcquireEyeBuffer(eye);
+                if (index < 0) {
+                    continue;
+                }
+                ++acquired;
+                void *texture = GetEyeBufferTexture(eye, index);
+                std::lock_guard<std::mutex> presentingLock(presentingMutex);
+                if (std::find(presenting.begin(), presenting.end(),
+                              texture) != presenting.end()) {
+                    ++handedOutWhilePresenting;
+                }
+            }
+            std::this_thread::yield();
+        }
+        renderThread.join();
+        StopHeadlessPlugin();
+        SetAsyncPresent(0);
+        SetEyeBufferCount(0);
+
+        CHECK(acquired > 0);
+        CHECK(handedOutWhilePresenting == 0);
+        CHECK(TakeFrameTimings().size() == static_cast<std::size_t>(frames));
+        CHECK(!PresentFailed(TakeLogged()));
+        LinkDebug(nullptr);
+    }
+}
+
+/// Unity's main thread rebuilding the buffers, then shutting down, while the
+/// render thread keeps frames in flight (2, or with timewarp, its slots):
+/// the render thread stops the present or timewarp thread for it each time,
+/// so nothing is released while presenting.
+static void TestConstructBuffersAcrossThreads() {
+    for (bool timewarp : {false, true}) {
+        auto config = Unpaced(2);
+        config.vsyncIntervalSeconds = 0.002;
+        if (timewarp) {
+            SetAsyncTimewarp(1);
+        } else {
+            SetAsyncPresent(2);
+        }
+        LinkDebug(Logged);
+        CHECK(StartHeadlessPlugin(config));
+        TakeLogged();
+        TakeFrameTimings();
+
+        std::atomic<bool> stop{false};
+        std::atomic<int> frames{0};
+        std::thread renderThread([&] {
+            const auto onRenderEvent = GetRenderEventFunc();
+            while (!stop) {
+                onRenderEvent(kOsvrEventID_Update);
+                onRenderEvent(kOsvrEventID_Render);
+                ++frames;
+            }
+            onRenderEvent(kOsvrEventID_Shutdown);
+        });
+        int rebuilt = 0;
+        for (int i = 0; i < 20; ++i) {
+            if (ConstructRenderBuffers() == OSVR_RETURN_SUCCESS) {
+                ++rebuilt;
+            }
+            const int before = frames;
+            while (frames < before + 5) {
+                std::this_thread::yield();
+            }
+        }
+        // With frames still in flight.
+        ShutdownRenderManager();
+        CHECK(GetRenderManagerStatus() == kOsvrRenderManagerStatus_None);
+        stop = true;
+        renderThread.join();
+        StopHeadlessPlugin();
+        SetAsyncTimewarp(0);
+        SetAsyncPresent(0);
+
+        CHECK(rebuilt == 20);
+        CHECK(!TakeFrameTimings().empty());
+        CHECK(!PresentFailed(TakeLogged()));
+        LinkDebug(nullptr);
+    }
+}
+
+static void TestAsyncCreation() {
+    useStandInRenderBackend(Unpaced(2));
+    UnityPluginLoad(GetFakeUnityInterfaces());
+    CHECK(CreateRenderManagerFromUnityAsync(nullptr) == OSVR_RETURN_SUCCESS);
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (GetRenderManagerStatus() !=
+               kOsvrRenderManagerStatus_WaitingForRenderThread &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(GetRenderManagerStatus() ==
+          kOsvrRenderManagerStatus_WaitingForRenderThread);
+    // A game that doesn't wait for Ready: nothing to use yet, but no crash.
+    TakeFrameTimings();
+    RenderFrames(3);
+    CHECK(ConstructRenderBuffers() == OSVR_RETURN_FAILURE);
+    CHECK(TakeFrameTimings().empty());
+
+    GetRenderEventFunc()(kOsvrEventID_FinishCreateRenderManager);
+    CHECK(GetRenderManagerStatus() == kOsvrRenderManagerStatus_Ready);
+    CHECK(ConstructRenderBuffers() == OSVR_RETURN_SUCCESS);
+    RenderFrames(5);
+    CHECK(TakeFrameTimings().size() == 5);
+    const auto startupTime = GetStartupTime();
+    CHECK(startupTime > 0);
+
+    // Asking again while running creates nothing, so restarts no clock.
+    CHECK(CreateRenderManagerFromUnity(nullptr) == OSVR_RETURN_SUCCESS);
+    RenderFrames(1);
+    CHECK(GetStartupTime() == startupTime);
+    StopHeadlessPlugin();
+}
+
+static void TestAsyncCreationRacesShutdown() {
+    useStandInRenderBackend(Unpaced(2));
+    UnityPluginLoad(GetFakeUnityInterfaces());
+    for (int i = 0; i < 50; ++i) {
+        CHECK(CreateRenderManagerFromUnityAsync(nullptr) ==
+              OSVR_RETURN_SUCCESS);
+        while (GetRenderManagerStatus() ==
+               kOsvrRenderManagerStatus_Creating) {
+            std::this_thread::yield();
+        }
+        // The render thread finishing the creation while the game gives up
+        // on it: exactly one of them gets the worker and what it made.
+        std::thread renderThread([] {
+            GetRenderEventFunc()(kOsvrEventID_FinishCreateRenderManager);
+            RenderFrames(2);
+        });
+        ShutdownRenderManager();
+        renderThread.join();
+        CHECK(GetRenderManagerStatus() == kOsvrRenderManagerStatus_None);
+    }
+    // Nothing was left behind to stop a fresh creation.
+    CHECK(CreateRenderManagerFromUnity(nullptr) == OSVR_RETURN_SUCCESS);
+    CHECK(ConstructRenderBuffers() == OSVR_RETURN_SUCCESS);
+    TakeFrameTimings();
+    RenderFrames(3);
+    CHECK(TakeFrameTimings().size() == 3);
+    StopHeadlessPlugin();
+}
+
+/// Run @p frames frames of a game whose render thread work alternates
+/// between half and 1.3 vsync intervals (0.9 on average), as with content
+/// that spikes every other frame.
+/// @return the mean time each render event held the render thread, in
+/// seconds; @p seconds is set to the time all frames took.
+static double RenderSpikyFrames(int frames, double vsyncInterval,
+                                double &seconds) {
+    using clock = std::chrono::steady_clock;
+    const auto onRenderEvent = GetRenderEventFunc();
+    clock::duration inRenderEvent{};
+    const auto start = clock::now();
+    for (int i = 0; i < frames; ++i) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(
+            (i % 2 == 0 ? 0.5 : 1.3) * vsyncInterval));
+        onRenderEvent(kOsvrEventID_Update);
+        const auto before = clock::now();
+        onRenderEvent(kOsvrEventID_Render);
+        inRenderEvent += clock::now() - before;
+    }
+    seconds = std::chrono::duration<double>(clock::now() - start).count();
+    return std::chrono::duration<double>(inRenderEvent).count() / frames;
+}
+
+static void TestAsyncPresentFreesRenderThread() {
+    auto config = Unpaced(2);
+    config.vsyncIntervalSeconds = 0.005;
+    const int frames = 60;
+    double syncSeconds = 0;
+    double asyncSeconds = 0;
+
+    CHECK(StartHeadlessPlugin(config));
+    const double syncHeld =
+        RenderSpikyFrames(frames, config.vsyncIntervalSeconds, syncSeconds);
+    StopHeadlessPlugin();
+
+    SetAsyncPresent(2);
+    CHECK(StartHeadlessPlugin(config));
+    const double asyncHeld =
+        RenderSpikyFrames(frames, config.vsyncIntervalSeconds, asyncSeconds);
+    StopHeadlessPlugin();
+    SetAsyncPresent(0);
+
+    std::printf("Render thread held per frame: %.2f ms synchronous, %.2f ms "
+                "with 2 frames in flight\n"
+                "%d frames took %.0f ms synchronous, %.0f ms with 2 frames "
+                "in flight (vsync %.0f ms)\n",
+                syncHeld * 1e3, asyncHeld * 1e3, frames, syncSeconds * 1e3,
+                asyncSeconds * 1e3, config.vsyncIntervalSeconds * 1e3);
+    // Synchronously, each spike misses a vsync and the render thread then
+    // waits out the next one; the present thread absorbs the spikes.
+    CHECK(asyncHeld < syncHeld / 2);
+    CHECK(asyncSeconds < 0.8 * syncSeconds);
+}
+
+static void TestDeviceReset() {
+    for (int framesInFlight : {0, 2}) {
+        SetAsyncPresent(framesInFlight);
+        LinkDebug(Logged);
+        CHECK(StartHeadlessPlugin(Unpaced(2)));
+        RenderFrames(10);
+
+        // The device is gone for a while between the two events.
+        const auto resetTime = std::chrono::milliseconds(5);
+        SendFakeDeviceEvent(kUnityGfxDeviceEventBeforeReset);
+        std::this_thread::sleep_for(resetTime);
+        SendFakeDeviceEvent(kUnityGfxDeviceEventAfterReset);
+        // BeforeReset stopped the present thread, which presented the frames
+        // in flight first.
+        TakeFrameTimings();
+        const auto recovery =
+            std::chrono::nanoseconds(GetLastDeviceResetRecoveryTime());
+        std::printf("Device reset recovery with %d frames in flight: "
+                    "%.3f ms\n",
+                    framesInFlight,
+                    std::chrono::duration<double, std::milli>(recovery)
+                        .count());
+        CHECK(recovery >= resetTime);
+        // Rebuilding the buffers takes nothing like a second.
+        CHECK(recovery < resetTime + std::chrono::seconds(1));
+        CHECK(GetRenderManagerStatus() == kOsvrRenderManagerStatus_Ready);
+
+        RenderFrames(10);
+        StopHeadlessPlugin();
+        CHECK(TakeFrameTimings().size() == 10);
+        CHECK(!PresentFailed(TakeLogged()));
+        LinkDebug(nullptr);
+    }
+    SetAsyncPresent(0);
+}
+
+static void TestAsyncTimewarp() {
+    auto config = Unpaced(2);
+    config.vsyncIntervalSeconds = 0.002;
+    SetAsyncTimewarp(1);
+    LinkDebug(Logged);
+    CHECK(StartHeadlessPlugin(config));
+    TakeLogged();
+    const auto fresh = GetFreshFrameCount();
+    const auto reprojected = GetReprojectedFrameCount();
+    const auto onRenderEvent = GetRenderEventFunc();
+    const int frames = 20;
+    for (int i = 0; i < frames; ++i) {
+        onRenderEvent(kOsvrEventID_Update);
+        onRenderEvent(kOsvrEventID_Render);
+        // A game running at under half the display rate.
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    StopHeadlessPlugin();
+    SetAsyncTimewarp(0);
+    const auto freshFrames = GetFreshFrameCount() - fresh;
+    const auto reprojectedFrames = GetReprojectedFrameCount() - reprojected;
+    // A frame is only skipped if two arrive within one vsync.
+    CHECK(freshFrames <= frames && freshFrames >= frames / 2);
+    CHECK(reprojectedFrames >= freshFrames);
+    CHECK(!PresentFailed(TakeLogged()));
+    LinkDebug(nullptr);
+}
+
+/// Eye 0's yaw sine from the latest render info, which the stand-in changes
+/// with every update.
+static double FrameYaw() {
+    OSVR_FrameState state;
+    CHECK(GetFrameState(&state) == OSVR_RETURN_SUCCESS);
+    return osvrQuatGetY(&state.eyes[0].pose.rotation);
+}
+
+/// Record @p frames frames and replay them, with the trace started before
+/// or after RenderManager is set up.
+static void RecordAndReplay(bool traceSetup) {
+    const char *const path = "HeadlessPluginTests.osvrtrace";
+    const int frames = 10;
+    const auto onRenderEvent = GetRenderEventFunc();
+
+    TakeFrameTimings();
+    if (traceSetup) {
+        // The trace also holds the render info fetched while setting up.
+        CHECK(StartPoseTrace(path, 1) == OSVR_RETURN_SUCCESS);
+    }
+    CHECK(StartHeadlessPlugin(Unpaced(2)));
+    if (!traceSetup) {
+        CHECK(StartPoseTrace(path, 1) == OSVR_RETURN_SUCCESS);
+    }
+    std::vector<double> recorded;
+    for (int i = 0; i < frames; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        onRenderEvent(kOsvrEventID_Update);
+        recorded.push_back(FrameYaw());
+        onRenderEvent(kOsvrEventID_Render);
+    }
+    StopHeadlessPlugin();
+    StopPoseTrace();
+    TakeFrameTimings();
+
+    // Replay the same events: each update sees what it saw when recorded.
+    CHECK(ConfigureTraceReplayBackend(path, 0) == OSVR_RETURN_SUCCESS);
+    UnityPluginLoad(GetFakeUnityInterfaces());
+    CHECK(CreateRenderManagerFromUnity(nullptr) == OSVR_RETURN_SUCCESS);
+    CHECK(ConstructRenderBuffers() == OSVR_RETURN_SUCCESS);
+    for (int i = 0; i < frames; ++i) {
+        onRenderEvent(kOsvrEventID_Update);
+        CHECK(FrameYaw() == recorded[i]);
+        onRenderEvent(kOsvrEventID_Render);
+    }
+    ShutdownRenderManager();
+    UnityPluginUnload();
+    CHECK(ConfigureTraceReplayBackend(nullptr, 0) == OSVR_RETURN_SUCCESS);
+    CHECK(TakeFrameTimings().size() == static_cast<std::size_t>(frames));
+    std::remove(path);
+}
+
+static void TestTraceReplay() {
+    RecordAndReplay(false);
+    RecordAndReplay(true);
+}
+
+int main() {
+    RUN_TEST(TestLifecycle);
+    RUN_TEST(TestEyeCounts);
+    RUN_TEST(TestVsyncPacing);
+    RUN_TEST(TestSwapChain);
+    RUN_TEST(TestSwapChainAcrossThreads);
+    RUN_TEST(TestConstructBuffersAcrossThreads);
+    RUN_TEST(TestAsyncCreation);
+    RUN_TEST(TestAsyncCreationRacesShutdown);
+    RUN_TEST(TestAsyncPresentFreesRenderThread);
+    RUN_TEST(TestAsyncTimewarp);
+    RUN_TEST(TestDeviceReset);
+    RUN_TEST(TestTraceReplay);
+    return TestExitStatus();
+}
@@ -0,0 +1,218 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HiddenAreaMesh.h"
+#include "TestHarness.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Hidden area meshes built from synthetic display descriptors, checked by
+/// the area they cover in the eye buffer's 0 to 1 square.
+
+/// Total area of a triangle list of x, y pairs.
+static double Area(const std::vector<float> &triangles) {
+    double area = 0;
+    for (std::size_t i = 0; i + 6 <= triangles.size(); i += 6) {
+        const double abx = triangles[i + 2] - triangles[i];
+        const double aby = triangles[i + 3] - triangles[i + 1];
+        const double acx = triangles[i + 4] - triangles[i];
+        const double acy = triangles[i + 5] - triangles[i + 1];
+        area += std::fabs(abx * acy - aby * acx) / 2;
+    }
+    return area;
+}
+
+/// A two-eye descriptor with each color's distortion polynomial given as a
+/// JSON array (empty for none).
+static std::string Descriptor(const std::string &red,
+                              const std::string &green,
+                              const std::string &blue,
+                              const std::string &extra = "",
+                              const std::string &hmdExtra = "") {
+    std::string distortion;
+    if (!red.empty()) {
+        distortion = "\"distortion\": {" + extra +
+                     "\"type\": \"rgb_symmetric_polynomials\", "
+                     "\"polynomial_coeffs_red\": " +
+                     red + ", \"polynomial_coeffs_green\": " + green +
+                     ", \"polynomial_coeffs_blue\": " + blue + "}, ";
+    }
+    return "{\"hmd\": {" + hmdExtra + distortion +
+           "\"eyes\": [{\"center_proj_x\": 0.4, \"center_proj_y\": 0.55}, "
+           "{\"center_proj_x\": 0.6, \"center_proj_y\": 0.55}]}}";
+}
+
+static bool Build(const std::string &descriptor,
+                  std::vector<HiddenAreaMesh> &meshes) {
+    std::vector<LensDistortion> eyes;
+    std::string error;
+    if (!ParseLensDistortion(descriptor, eyes, error)) {
+        std::printf("ParseLensDistortion: %s\n", error.c_str());
+        return false;
+    }
+    meshes.clear();
+    for (const auto &eye : eyes) {
+        meshes.push_back(BuildHiddenAreaMesh(eye));
+    }
+    return true;
+}
+
+static void TestNoDistortionHidesNothing() {
+    std::vector<HiddenAreaMesh> meshes;
+    CHECK(Build(Descriptor("", "", ""), meshes));
+    CHECK(meshes.size() == 2);
+    for (const auto &mesh : meshes) {
+        CHECK(mesh.hidden.empty());
+        CHECK(std::fabs(Area(mesh.visible) - 1) < 1e-5);
+    }
+}
+
+static void TestUniformScaleHidesOuterRing() {
+    // Every ray reaches 0.8 of the way to the buffer's edge, so the visible
+    // area is the buffer shrunk by 0.8 about the center of projection.
+    std::vector<HiddenAreaMesh> meshes;
+    CHECK(Build(Descriptor("[0, 0.8]", "[0, 0.8]", "[0, 0.8]"), meshes));
+    CHECK(meshes.size() == 2);
+    for (const auto &mesh : meshes) {
+        const double hidden = Area(mesh.hidden);
+        const double visible = Area(mesh.visible);
+        std::printf("hidden %.5f, visible %.5f\n", hidden, visible);
+        CHECK(std::fabs(hidden + visible - 1) < 1e-5);
+        CHECK(std::fabs(hidden - 0.36) < 1e-4);
+    }
+}
+
+static void TestDistanceScaleKeepsLinearScale() {
+    // A linear polynomial scales the same in any units.
+    std::vector<HiddenAreaMesh> meshes;
+    CHECK(Build(Descriptor("[0, 0.8]", "[0, 0.8]", "[0, 0.8]",
+                           "\"distance_scale_x\": 2, "
+                           "\"distance_scale_y\": 0.5, "),
+                meshes));
+    for (const auto &mesh : meshes) {
+        CHECK(std::fabs(Area(mesh.hidden) - 0.36) < 1e-4);
+        CHECK(std::fabs(Area(mesh.visible) - 0.64) < 1e-4);
+    }
+}
+
+static void TestWidestColorIsVisible() {
+    // Pixels any color samples stay visible.
+    std::vector<HiddenAreaMesh> meshes;
+    CHECK(Build(Descriptor("[0, 0.8]", "[0, 0.9]", "[0, 0.7]"), meshes));
+    for (const auto &mesh : meshes) {
+        CHECK(std::fabs(Area(mesh.visible) - 0.81) < 1e-4);
+        CHECK(std::fabs(Area(mesh.hidden) - 0.19) < 1e-4);
+    }
+}
+
+static const char *const FieldOfView =
+    "\"field_of_view\": {\"monocular_horizontal\": 90, "
+    "\"monocular_vertical\": 90}, ";
+
+static void TestLensOutlineHidesCorners() {
+    // No distortion and a centered lens: the hidden area is what lies
+    // outside the buffer's inscribed circle.
+    std::vector<HiddenAreaMesh> meshes;
+    CHECK(Build(std::string("{\"hmd\": {") + FieldOfView +
+                    "\"eyes\": [{}]}}",
+                meshes));
+    CHECK(meshes.size() == 1);
+    const double Pi = 3.14159265358979323846;
+    const double hidden = Area(meshes[0].hidden);
+    const double visible = Area(meshes[0].visible);
+    std::printf("hidden %.5f, visible %.5f\n", hidden, visible);
+    CHECK(std::fabs(hidden + visible - 1) < 1e-5);
+    CHECK(std::fabs(hidden - (1 - Pi / 4)) < 2e-3);
+    // Pushed out, so nothing the lens shows is hidden.
+    CHECK(hidden < 1 - Pi / 4);
+}
+
+static void TestLensOutlineReachesFarthestEdge() {
+    // Centers of projection at 0.4 and 0.6 by 0.55: the lens reaches 0.6
+    // across and 0.55 up, so less of the corners is hidden than for a
+    // centered lens, and the distortion's ring still is.
+    std::vector<HiddenAreaMesh> meshes;
+    CHECK(Build(Descriptor("", "", "", "", FieldOfView), meshes));
+    for (const auto &mesh : meshes) {
+        const double hidden = Area(mesh.hidden);
+        CHECK(std::fabs(hidden + Area(mesh.visible) - 1) < 1e-5);
+        CHECK(hidden > 0.01 && hidden < 0.2);
+    }
+    CHECK(Build(Descriptor("[0, 0.8]", "[0, 0.8]", "[0, 0.8]", "",
+                           FieldOfView),
+                meshes));
+    for (const auto &mesh : meshes) {
+        CHECK(Area(mesh.hidden) > 0.36 + 1e-3);
+    }
+}
+
+static void TestDistortionsCompare() {
+    std::vector<LensDistortion> a, b;
+    std::string error;
+    CHECK(ParseLensDistortion(Descriptor("[0, 0.8]", "[0, 0.8]", "[0, 0.8]"),
+                              a, error));
+    CHECK(ParseLensDistortion(Descriptor("[0, 0.8]", "[0, 0.8]", "[0, 0.8]"),
+                              b, error));
+    CHECK(a == b);
+    CHECK(ParseLensDistortion(Descriptor("[0, 0.8]", "[0, 0.8]", "[0, 0.8]",
+                                         "", FieldOfView),
+                              b, error));
+    CHECK(a != b);
+    CHECK(ParseLensDistortion(Descriptor("[0, 0.8]", "[0, 0.9]", "[0, 0.8]"),
+                              b, error));
+    CHECK(a != b);
+}
+
+static void TestRejectsUnusableDescriptors() {
+    std::vector<LensDistortion> eyes;
+    std::string error;
+    CHECK(!ParseLensDistortion("{", eyes, error));
+    CHECK(!ParseLensDistortion("{\"hmd\": {\"eyes\": []}}", eyes, error));
+    CHECK(!ParseLensDistortion(
+        "{\"hmd\": {\"distortion\": {\"type\": \"mono_point_samples\"}, "
+        "\"eyes\": [{}]}}",
+        eyes, error));
+    CHECK(!ParseLensDistortion(
+        "{\"hmd\": {\"eyes\": [{\"center_proj_x\": 1.5}]}}", eyes, error));
+}
+
+int main() {
+    RUN_TEST(TestNoDistortionHidesNothing);
+    RUN_TEST(TestUniformScaleHidesOuterRing);
+    RUN_TEST(TestDistanceScaleKeepsLinearScale);
+    RUN_TEST(TestWidestColorIsVisible);
+    RUN_TEST(TestLensOutlineHidesCorners);
+    RUN_TEST(TestLensOutlineReachesFarthestEdge);
+    RUN_TEST(TestDistortionsCompare);
+    RUN_TEST(TestRejectsUnusableDescriptors);
+    return TestExitStatus();
+}
@@ -0,0 +1,146 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "FakeUnityHost.h"
+#include "OsvrRenderingPlugin.h"
+
+// Library/third-party includes
+#include <benchmark/benchmark.h>
+
+// Standard includes
+// - none
+
+/// Micro and macro benchmarks of the plugin's per-frame paths, on the
+/// stand-in backend with no vsync wait, by eye count. Use
+/// --benchmark_format=json (or --benchmark_out=<file>) to keep results for
+/// comparing releases.
+
+static StandInRenderBackendConfig Unpaced(benchmark::State &state) {
+    StandInRenderBackendConfig config;
+    config.eyeCount = static_cast<std::size_t>(state.range(0));
+    config.vsyncIntervalSeconds = 0;
+    return config;
+}
+
+/// Start the plugin for one benchmark run; skips the run if that fails.
+static bool Start(benchmark::State &state) {
+    if (!StartHeadlessPlugin(Unpaced(state))) {
+        state.SkipWithError("Could not start the plugin");
+        return false;
+    }
+    return true;
+}
+
+static void BM_UpdateEvent(benchmark::State &state) {
+    if (!Start(state)) {
+        return;
+    }
+    const auto onRenderEvent = GetRenderEventFunc();
+    for (auto _ : state) {
+        onRenderEvent(kOsvrEventID_Update);
+    }
+    StopHeadlessPlugin();
+}
+BENCHMARK(BM_UpdateEvent)->Arg(2)->Arg(4)->Arg(8);
+
+static void BM_RenderEvent(benchmark::State &state) {
+    if (!Start(state)) {
+        return;
+    }
+    const auto onRenderEvent = GetRenderEventFunc();
+    for (auto _ : state) {
+        onRenderEvent(kOsvrEventID_Render);
+    }
+    StopHeadlessPlugin();
+}
+BENCHMARK(BM_RenderEvent)->Arg(2)->Arg(4)->Arg(8);
+
+/// Every per-eye getter, for every eye.
+static void BM_EyeGetters(benchmark::State &state) {
+    if (!Start(state)) {
+        return;
+    }
+    const int eyes = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        for (int eye = 0; eye < eyes; ++eye) {
+            benchmark::DoNotOptimize(GetViewport(eye));
+            benchmark::DoNotOptimize(GetProjectionMatrix(eye));
+            benchmark::DoNotOptimize(GetEyePose(eye));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * eyes);
+    StopHeadlessPlugin();
+}
+BENCHMARK(BM_EyeGetters)->Arg(2)->Arg(4)->Arg(8);
+
+static void BM_GetFrameState(benchmark::State &state) {
+    if (!Start(state)) {
+        return;
+    }
+    OSVR_FrameState frameState;
+    for (auto _ : state) {
+        GetFrameState(&frameState);
+        benchmark::DoNotOptimize(frameState);
+    }
+    StopHeadlessPlugin();
+}
+BENCHMARK(BM_GetFrameState)->Arg(2)->Arg(4)->Arg(8);
+
+static void BM_ConstructRenderBuffers(benchmark::State &state) {
+    if (!Start(state)) {
+        return;
+    }
+    for (auto _ : state) {
+        if (ConstructRenderBuffers() != OSVR_RETURN_SUCCESS) {
+            state.SkipWithError("ConstructRenderBuffers failed");
+            break;
+        }
+    }
+    StopHeadlessPlugin();
+}
+BENCHMARK(BM_ConstructRenderBuffers)->Arg(2)->Arg(4)->Arg(8);
+
+/// A whole frame as a game drives it: update, read every eye, render.
+static void BM_Frame(benchmark::State &state) {
+    if (!Start(state)) {
+        return;
+    }
+    const auto onRenderEvent = GetRenderEventFunc();
+    const int eyes = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        onRenderEvent(kOsvrEventID_Update);
+        for (int eye = 0; eye < eyes; ++eye) {
+            benchmark::DoNotOptimize(GetViewport(eye));
+            benchmark::DoNotOptimize(GetProjectionMatrix(eye));
+            benchmark::DoNotOptimize(GetEyePose(eye));
+        }
+        onRenderEvent(kOsvrEventID_Render);
+    }
+    StopHeadlessPlugin();
+}
+BENCHMARK(BM_Frame)->Arg(2)->Arg(4)->Arg(8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,193 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PosePredictor.h"
+#include "PoseTraceReader.h"
+#include "PoseTraceRecorder.h"
+#include "TestHarness.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/// Head motion replayed from a pose trace through PosePredictor the way the
+/// plugin uses it: predict at the update event to the display time, then
+/// late-latch just before presenting, and again for each timewarp repeat.
+
+struct TrackerSample {
+    double time;
+    OSVR_PoseState pose;
+};
+
+static const char *const TracePath = "PosePredictionTests.osvrtrace";
+static const double TrackerPeriod = 0.002;
+
+static double Sine(double amplitude, double hertz, double t) {
+    return amplitude * std::sin(2 * 3.14159265358979 * hertz * t);
+}
+
+/// Three seconds of head turning and nodding, as a tracker reporting every
+/// TrackerPeriod would see it, written as head pose records.
+static bool RecordHeadTrace() {
+    PoseTraceRecorder recorder;
+    if (!recorder.open(TracePath, 1 << 20, 0)) {
+        return false;
+    }
+    for (int i = 0; i < 1500; ++i) {
+        const double t = i * TrackerPeriod;
+        const double yaw = Sine(0.8, 0.7, t) + Sine(0.2, 2.3, t);
+        const double pitch = Sine(0.3, 1.1, t);
+        // Yaw about y, then pitch about x.
+        const double yw = std::cos(yaw / 2), yy = std::sin(yaw / 2);
+        const double pw = std::cos(pitch / 2), px = std::sin(pitch / 2);
+        PoseTraceRenderInfo record = {};
+        record.header.type = kPoseTraceRecord_RenderInfo;
+        record.header.time = static_cast<std::int64_t>(t * 1e9 + 0.5);
+        record.translation[0] = Sine(0.05, 0.5, t);
+        record.translation[1] = 1.7;
+        record.rotation[0] = yw * pw;
+        record.rotation[1] = yw * px;
+        record.rotation[2] = yy * pw;
+        record.rotation[3] = -yy * px;
+        recorder.append(record);
+    }
+    recorder.close();
+    return recorder.dropped() == 0;
+}
+
+static std::vector<TrackerSample> ReadHeadTrace() {
+    std::vector<TrackerSample> samples;
+    PoseTraceReader trace;
+    CHECK(trace.load(TracePath));
+    CHECK(trace.complete());
+    trace.visit([&](const PoseTraceRecordHeader &rh, const char *bytes) {
+        if (rh.type != kPoseTraceRecord_RenderInfo) {
+            return;
+        }
+        PoseTraceRenderInfo record;
+        PoseTraceReader::read(rh, bytes, record);
+        TrackerSample sample = {};
+        sample.time = static_cast<double>(record.header.time) * 1e-9;
+        osvrVec3SetX(&sample.pose.translation, record.translation[0]);
+        osvrVec3SetY(&sample.pose.translation, record.translation[1]);
+        osvrVec3SetZ(&sample.pose.translation, record.translation[2]);
+        osvrQuatSetW(&sample.pose.rotation, record.rotation[0]);
+        osvrQuatSetX(&sample.pose.rotation, record.rotation[1]);
+        osvrQuatSetY(&sample.pose.rotation, record.rotation[2]);
+        osvrQuatSetZ(&sample.pose.rotation, record.rotation[3]);
+        samples.push_back(sample);
+    });
+    std::remove(TracePath);
+    return samples;
+}
+
+/// Radians between two orientations.
+static double AngleBetween(const OSVR_PoseState &a, const OSVR_PoseState &b) {
+    const double dot = osvrQuatGetW(&a.rotation) * osvrQuatGetW(&b.rotation) +
+                       osvrQuatGetX(&a.rotation) * osvrQuatGetX(&b.rotation) +
+                       osvrQuatGetY(&a.rotation) * osvrQuatGetY(&b.rotation) +
+                       osvrQuatGetZ(&a.rotation) * osvrQuatGetZ(&b.rotation);
+    return 2 * std::acos(std::fabs(dot) < 1 ? std::fabs(dot) : 1);
+}
+
+static OSVR_PoseState Predict(PosePredictor &predictor, double time) {
+    OSVR_PoseState pose = {};
+    predictor.predictAll(time, &pose, 1);
+    return pose;
+}
+
+static void TestLateLatchKeepsPrediction() {
+    CHECK(RecordHeadTrace());
+    const auto samples = ReadHeadTrace();
+    CHECK(samples.size() == 1500);
+    if (samples.size() != 1500) {
+        return;
+    }
+
+    // In tracker periods: a frame every 16 ms, displayed 40 ms after its
+    // update event; late-latched 10 ms before that, and a timewarp repeat
+    // 16 ms later.
+    const std::size_t framePeriod = 8, lead = 20, latch = 15, repeat = 8;
+    PosePredictor predictor;
+    std::size_t fed = 0;
+    auto feedThrough = [&](std::size_t last) {
+        for (; fed <= last; ++fed) {
+            predictor.addSample(0, samples[fed].time, samples[fed].pose);
+        }
+    };
+
+    double updateError = 0, rawLatchError = 0, latchError = 0;
+    double rawRepeatError = 0, repeatError = 0;
+    int frames = 0;
+    for (std::size_t update = 100;
+         update + lead + repeat < samples.size(); update += framePeriod) {
+        const double target = samples[update + lead].time;
+        feedThrough(update);
+        updateError += AngleBetween(Predict(predictor, target),
+                                    samples[update + lead].pose);
+
+        // What the plugin used to late-latch: the pose as of the latch,
+        // which undoes the rest of the prediction.
+        feedThrough(update + latch);
+        rawLatchError += AngleBetween(samples[update + latch].pose,
+                                      samples[update + lead].pose);
+        latchError += AngleBetween(Predict(predictor, target),
+                                   samples[update + lead].pose);
+
+        // A timewarp repeat is seen as much later as it is latched later.
+        feedThrough(update + latch + repeat);
+        const double repeatTarget =
+            target + samples[update + latch + repeat].time -
+            samples[update + latch].time;
+        rawRepeatError += AngleBetween(samples[update + latch + repeat].pose,
+                                       samples[update + lead + repeat].pose);
+        repeatError += AngleBetween(Predict(predictor, repeatTarget),
+                                    samples[update + lead + repeat].pose);
+        ++frames;
+    }
+
+    std::printf("Mean head rotation error over %d frames: %.3f deg predicted "
+                "at update, %.3f deg late-latched unpredicted, %.3f deg "
+                "late-latched predicted; timewarp repeat %.3f deg "
+                "unpredicted, %.3f deg predicted\n",
+                frames, updateError / frames * 57.2958,
+                rawLatchError / frames * 57.2958,
+                latchError / frames * 57.2958,
+                rawRepeatError / frames * 57.2958,
+                repeatError / frames * 57.2958);
+    CHECK(latchError < rawLatchError / 2);
+    CHECK(latchError < updateError);
+    CHECK(repeatError < rawRepeatError / 2);
+}
+
+int main() {
+    RUN_TEST(TestLateLatchKeepsPrediction);
+    return TestExitStatus();
+}
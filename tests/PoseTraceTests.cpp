@@ -0,0 +1,119 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseTraceReader.h"
+#include "PoseTraceRecorder.h"
+#include "TestHarness.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdio>
+#include <fstream>
+
+/// What PoseTraceRecorder leaves on disk, as PoseTraceReader sees it.
+
+static const char *const TracePath = "PoseTraceTests.osvrtrace";
+
+static std::streamoff FileSize(const char *path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in ? static_cast<std::streamoff>(in.tellg()) : -1;
+}
+
+static int CountRecords(const PoseTraceReader &trace) {
+    int records = 0;
+    trace.visit([&](const PoseTraceRecordHeader &, const char *) {
+        ++records;
+    });
+    return records;
+}
+
+static void AppendEvents(PoseTraceRecorder &recorder, int events) {
+    for (int i = 0; i < events; ++i) {
+        PoseTraceRenderEvent record = {};
+        record.header.type = kPoseTraceRecord_RenderEvent;
+        record.header.time = i + 1;
+        record.eventID = i;
+        recorder.append(record);
+    }
+}
+
+static void TestEmptyTraceIsComplete() {
+    PoseTraceRecorder recorder;
+    CHECK(recorder.open(TracePath, 4096, 0));
+    recorder.close();
+
+    PoseTraceReader trace;
+    CHECK(trace.load(TracePath));
+    CHECK(trace.complete());
+    CHECK(trace.header().recordBytes == 0);
+    CHECK(CountRecords(trace) == 0);
+    CHECK(FileSize(TracePath) ==
+          static_cast<std::streamoff>(sizeof(PoseTraceFileHeader)));
+    std::remove(TracePath);
+}
+
+static void TestUnclosedTraceIsIncomplete() {
+    PoseTraceRecorder recorder;
+    CHECK(recorder.open(TracePath, 4096, 0));
+    AppendEvents(recorder, 3);
+
+    // As a reader would find it if the process died now.
+    PoseTraceReader trace;
+    CHECK(trace.load(TracePath));
+    CHECK(!trace.complete());
+    CHECK(CountRecords(trace) == 3);
+    recorder.close();
+    std::remove(TracePath);
+}
+
+static void TestOverflowKeepsWholeRecords() {
+    // Room for two and a half events.
+    const std::size_t capacity =
+        sizeof(PoseTraceFileHeader) + 5 * sizeof(PoseTraceRenderEvent) / 2;
+    const std::size_t kept = 2 * sizeof(PoseTraceRenderEvent);
+    PoseTraceRecorder recorder;
+    CHECK(recorder.open(TracePath, capacity, 0));
+    AppendEvents(recorder, 5);
+    recorder.close();
+    CHECK(recorder.dropped() == 3);
+
+    PoseTraceReader trace;
+    CHECK(trace.load(TracePath));
+    CHECK(trace.complete());
+    CHECK(trace.header().recordBytes == kept);
+    CHECK(CountRecords(trace) == 2);
+    CHECK(FileSize(TracePath) ==
+          static_cast<std::streamoff>(sizeof(PoseTraceFileHeader) + kept));
+    std::remove(TracePath);
+}
+
+int main() {
+    RUN_TEST(TestEmptyTraceIsComplete);
+    RUN_TEST(TestUnclosedTraceIsIncomplete);
+    RUN_TEST(TestOverflowKeepsWholeRecords);
+    return TestExitStatus();
+}
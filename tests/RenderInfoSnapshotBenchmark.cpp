@@ -0,0 +1,176 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "RenderInfoSnapshot.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/// Getter latency under contention: several threads read one eye's render
+/// info at random times, like game scripts calling the getters, while a fake
+/// render loop publishes new poses every frame. Compares RenderInfoSnapshot
+/// with the mutex it replaced, which the render loop also held across its
+/// present (the vsync wait).
+///
+/// Usage: osvrRenderInfoSnapshotBenchmark [seconds per variant] [readers]
+
+using RenderInfo = osvr::renderkit::RenderInfo;
+using clock_type = std::chrono::steady_clock;
+
+/// Simulated frame: the render loop publishes, then presents for
+/// PresentTime (holding the mutex, in the old scheme) and idles for the
+/// rest of the frame.
+static const std::chrono::microseconds FrameTime(4000);
+static const std::chrono::microseconds PresentTime(2000);
+static const std::size_t Eyes = 2;
+
+/// The old scheme: one mutex around the render info vector.
+struct MutexRenderInfo {
+    std::mutex mutex;
+    std::vector<RenderInfo> renderInfo;
+
+    void publishAndPresent(const std::vector<RenderInfo> &infos) {
+        std::lock_guard<std::mutex> lock(mutex);
+        renderInfo = infos;
+        std::this_thread::sleep_for(PresentTime);
+    }
+    RenderInfo readEye(std::size_t eye) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return eye < renderInfo.size() ? renderInfo[eye] : RenderInfo();
+    }
+};
+
+/// The new scheme: publishing never waits on readers, and the present
+/// holds nothing.
+struct SnapshotRenderInfo {
+    RenderInfoSnapshot snapshot;
+
+    void publishAndPresent(const std::vector<RenderInfo> &infos) {
+        snapshot.publish(infos);
+        std::this_thread::sleep_for(PresentTime);
+    }
+    RenderInfo readEye(std::size_t eye) {
+        RenderInfo ri = {};
+        snapshot.readEye(eye, ri);
+        return ri;
+    }
+};
+
+/// Run the readers and the render loop for @p seconds and print getter
+/// latency percentiles.
+template <typename Shared>
+static void Measure(const char *name, double seconds, int readers) {
+    Shared shared;
+    std::vector<RenderInfo> infos(Eyes);
+    shared.publishAndPresent(infos);
+
+    std::atomic<bool> stop{false};
+    std::thread renderLoop([&] {
+        double x = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            const auto frameStart = clock_type::now();
+            x += 0.001;
+            for (auto &ri : infos) {
+                ri.pose.translation.data[0] = x;
+            }
+            shared.publishAndPresent(infos);
+            std::this_thread::sleep_until(frameStart + FrameTime);
+        }
+    });
+
+    std::vector<std::vector<double>> latencies(readers);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            auto &samples = latencies[r];
+            std::minstd_rand random(static_cast<unsigned>(r + 1));
+            std::uniform_int_distribution<int> pause(0, 500);
+            double sink = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const auto before = clock_type::now();
+                sink += shared.readEye(r % Eyes).pose.translation.data[0];
+                const auto after = clock_type::now();
+                samples.push_back(
+                    std::chrono::duration<double, std::micro>(after - before)
+                        .count());
+                std::this_thread::sleep_for(
+                    std::chrono::microseconds(pause(random)));
+            }
+            if (sink < 0) {
+                std::printf("%f\n", sink);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    renderLoop.join();
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::vector<double> all;
+    for (const auto &samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+    const auto percentile = [&](double p) {
+        return all[static_cast<std::size_t>(
+            p * static_cast<double>(all.size() - 1))];
+    };
+    std::printf("%-18s %8zu reads  p50 %7.2f us  p99 %7.2f us  "
+                "max %7.1f us\n",
+                name, all.size(), percentile(0.5), percentile(0.99),
+                all.back());
+}
+
+int main(int argc, char *argv[]) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    const int readers = argc > 2 ? std::atoi(argv[2]) : 4;
+    if (seconds <= 0 || readers <= 0) {
+        std::fprintf(stderr, "Usage: %s [seconds per variant] [readers]\n",
+                     argv[0]);
+        return 1;
+    }
+    std::printf("%d reader threads, %.1f s each; the render loop holds the "
+                "mutex %lld of every %lld us\n",
+                readers, seconds,
+                static_cast<long long>(PresentTime.count()),
+                static_cast<long long>(FrameTime.count()));
+    Measure<MutexRenderInfo>("mutex (before)", seconds, readers);
+    Measure<SnapshotRenderInfo>("snapshot (after)", seconds, readers);
+    return 0;
+}
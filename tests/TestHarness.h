@@ -0,0 +1,69 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_TestHarness_h_GUID_9E2B47C0_A8D3_4F15_B6E9_0C4D71A38F52
+#define INCLUDED_TestHarness_h_GUID_9E2B47C0_A8D3_4F15_B6E9_0C4D71A38F52
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdio>
+
+/// Just enough to write self-checking tests without a test framework: each
+/// test program runs its tests with RUN_TEST and returns TestExitStatus(),
+/// which is what CTest looks at.
+
+inline int &TestFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+/// Record a failure, with where and what, if @p expr is false, and carry on.
+#define CHECK(expr)                                                            \
+    do {                                                                       \
+        if (!(expr)) {                                                         \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__,       \
+                        #expr);                                                \
+            ++TestFailures();                                                  \
+        }                                                                      \
+    } while (0)
+
+#define RUN_TEST(test)                                                         \
+    do {                                                                       \
+        const int failuresBefore = TestFailures();                             \
+        std::printf("[ RUN  ] %s\n", #test);                                   \
+        test();                                                                \
+        std::printf("[ %s ] %s\n",                                             \
+                    TestFailures() == failuresBefore ? " OK " : "FAIL",        \
+                    #test);                                                    \
+    } while (0)
+
+inline int TestExitStatus() { return TestFailures() == 0 ? 0 : 1; }
+
+#endif // INCLUDED_TestHarness_h_GUID_9E2B47C0_A8D3_4F15_B6E9_0C4D71A38F52
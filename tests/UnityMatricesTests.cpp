@@ -0,0 +1,215 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TestHarness.h"
+#include "UnityMatrices.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstdio>
+
+/// ComputeUnityEyeMatrices against matrices and planes worked out by hand
+/// for Unity's conventions: left-handed world, camera looking down -Z in
+/// view space, clip Z in [-1, 1], planes as (normal, distance) with normals
+/// pointing into the frustum.
+
+static const double Tolerance = 1e-5;
+
+static bool Near(const float *actual, const double *expected, int n) {
+    bool near = true;
+    for (int i = 0; i < n; ++i) {
+        if (std::fabs(actual[i] - expected[i]) > Tolerance) {
+            std::printf("  [%d] is %.6f, expected %.6f\n", i, actual[i],
+                        expected[i]);
+            near = false;
+        }
+    }
+    return near;
+}
+
+/// Plane @p expected (x, y, z, distance) scaled to a unit normal.
+static bool NearPlane(const float *actual, const double (&expected)[4]) {
+    const double length =
+        std::sqrt(expected[0] * expected[0] + expected[1] * expected[1] +
+                  expected[2] * expected[2]);
+    const double unit[4] = {expected[0] / length, expected[1] / length,
+                            expected[2] / length, expected[3] / length};
+    return Near(actual, unit, 4);
+}
+
+/// a * b, column-major, in double precision.
+static void Multiply(const double *a, const double *b, double *out) {
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            double sum = 0;
+            for (int k = 0; k < 4; ++k) {
+                sum += a[4 * k + row] * b[4 * col + k];
+            }
+            out[4 * col + row] = sum;
+        }
+    }
+}
+
+static OSVR_PoseState Pose(double x, double y, double z, double qw,
+                           double qx, double qy, double qz) {
+    OSVR_PoseState pose = {};
+    pose.translation.data[0] = x;
+    pose.translation.data[1] = y;
+    pose.translation.data[2] = z;
+    pose.rotation.data[0] = qw;
+    pose.rotation.data[1] = qx;
+    pose.rotation.data[2] = qy;
+    pose.rotation.data[3] = qz;
+    return pose;
+}
+
+static osvr::renderkit::OSVR_ProjectionMatrix
+Projection(double left, double right, double top, double bottom,
+           double nearClip, double farClip) {
+    osvr::renderkit::OSVR_ProjectionMatrix projection = {};
+    projection.left = left;
+    projection.right = right;
+    projection.top = top;
+    projection.bottom = bottom;
+    projection.nearClip = nearClip;
+    projection.farClip = farClip;
+    return projection;
+}
+
+static void TestIdentityPoseSymmetricFrustum() {
+    // At the origin looking down Unity's +Z, a 90 degree square frustum
+    // from 1 to 3 meters.
+    const auto pose = Pose(0, 0, 0, 1, 0, 0, 0);
+    const auto projection = Projection(-1, 1, 1, -1, 1, 3);
+    OSVR_EyeMatrices m;
+    ComputeUnityEyeMatrices(&pose, &projection, 1, false, &m);
+
+    // Column by column.
+    const double view[16] = {1, 0, 0,  0, //
+                             0, 1, 0,  0, //
+                             0, 0, -1, 0, //
+                             0, 0, 0,  1};
+    const double proj[16] = {1, 0, 0,  0,  //
+                             0, 1, 0,  0,  //
+                             0, 0, -2, -1, //
+                             0, 0, -3, 0};
+    const double viewProj[16] = {1, 0, 0,  0, //
+                                 0, 1, 0,  0, //
+                                 0, 0, 2,  1, //
+                                 0, 0, -3, 0};
+    CHECK(Near(m.view, view, 16));
+    CHECK(Near(m.projection, proj, 16));
+    CHECK(Near(m.viewProjection, viewProj, 16));
+
+    const double planes[6][4] = {{1, 0, 1, 0},  {-1, 0, 1, 0},
+                                 {0, 1, 1, 0},  {0, -1, 1, 0},
+                                 {0, 0, 1, -1}, {0, 0, -1, 3}};
+    for (int i = 0; i < 6; ++i) {
+        CHECK(NearPlane(m.frustumPlanes[i], planes[i]));
+    }
+}
+
+static void TestTurnedOffsetEyeAsymmetricFrustum() {
+    // At OSVR (1, 2, 3), turned 90 degrees left about +Y: in Unity's world
+    // that is (1, 2, -3) looking down -X. The frustum reaches 1 m left and
+    // 3 m right per meter ahead, 2 m up and down, from 0.5 to 10 m.
+    const double h = std::sqrt(0.5);
+    const auto pose = Pose(1, 2, 3, h, 0, h, 0);
+    const auto projection = Projection(-0.5, 1.5, 1, -1, 0.5, 10);
+    OSVR_EyeMatrices m[2];
+    ComputeUnityEyeMatrices(&pose, &projection, 1, false, &m[0]);
+    ComputeUnityEyeMatrices(&pose, &projection, 1, true, &m[1]);
+
+    // View space (x, y, z) = (z + 3, y - 2, x - 1) for Unity world (x, y, z).
+    const double view[16] = {0, 0,  1,  0, //
+                             0, 1,  0,  0, //
+                             1, 0,  0,  0, //
+                             3, -2, -1, 1};
+    const double proj[16] = {0.5, 0,   0,           0,  //
+                             0,   0.5, 0,           0,  //
+                             0.5, 0,   -10.5 / 9.5, -1, //
+                             0,   0,   -10 / 9.5,   0};
+    double viewProj[16];
+    Multiply(proj, view, viewProj);
+    CHECK(Near(m[0].view, view, 16));
+    CHECK(Near(m[0].projection, proj, 16));
+    CHECK(Near(m[0].viewProjection, viewProj, 16));
+
+    // Derived in view space from x / -z in [-1, 3], y / -z in [-2, 2] and
+    // -z in [0.5, 10], then moved into the world.
+    const double planes[6][4] = {{-1, 0, 1, 4},   {-3, 0, -1, 0},
+                                 {-2, 1, 0, 0},   {-2, -1, 0, 4},
+                                 {-1, 0, 0, 0.5}, {1, 0, 0, 9}};
+    for (int i = 0; i < 6; ++i) {
+        CHECK(NearPlane(m[0].frustumPlanes[i], planes[i]));
+    }
+
+    // Flipping Y negates clip-space Y (row 1) and nothing else.
+    double flippedProj[16];
+    double flippedViewProj[16];
+    for (int i = 0; i < 16; ++i) {
+        flippedProj[i] = i % 4 == 1 ? -proj[i] : proj[i];
+        flippedViewProj[i] = i % 4 == 1 ? -viewProj[i] : viewProj[i];
+    }
+    CHECK(Near(m[1].view, view, 16));
+    CHECK(Near(m[1].projection, flippedProj, 16));
+    CHECK(Near(m[1].viewProjection, flippedViewProj, 16));
+    for (int i = 0; i < 6; ++i) {
+        CHECK(NearPlane(m[1].frustumPlanes[i], planes[i]));
+    }
+}
+
+static void TestEyesAreIndependent() {
+    // Two eyes in one call come out as each would alone.
+    const double h = std::sqrt(0.5);
+    const OSVR_PoseState poses[2] = {Pose(-0.03, 0, 0, 1, 0, 0, 0),
+                                     Pose(1, 2, 3, h, 0, h, 0)};
+    const osvr::renderkit::OSVR_ProjectionMatrix projections[2] = {
+        Projection(-1, 1, 1, -1, 1, 3), Projection(-0.5, 1.5, 1, -1, 0.5, 10)};
+    OSVR_EyeMatrices both[2];
+    ComputeUnityEyeMatrices(poses, projections, 2, false, both);
+    for (int eye = 0; eye < 2; ++eye) {
+        OSVR_EyeMatrices alone;
+        ComputeUnityEyeMatrices(&poses[eye], &projections[eye], 1, false,
+                                &alone);
+        double expected[16];
+        for (int i = 0; i < 16; ++i) {
+            expected[i] = alone.viewProjection[i];
+        }
+        CHECK(Near(both[eye].viewProjection, expected, 16));
+    }
+    // The left eye sits 3 cm to the left: view translation x is +0.03.
+    CHECK(std::fabs(both[0].view[12] - 0.03) < Tolerance);
+}
+
+int main() {
+    RUN_TEST(TestIdentityPoseSymmetricFrustum);
+    RUN_TEST(TestTurnedOffsetEyeAsymmetricFrustum);
+    RUN_TEST(TestEyesAreIndependent);
+    return TestExitStatus();
+}